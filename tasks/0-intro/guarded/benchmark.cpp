@@ -0,0 +1,74 @@
+#include <benchmark/benchmark.h>
+
+#include "guarded.hpp"
+
+#include <atomic>
+#include <map>
+#include <queue>
+#include <vector>
+
+// Highly contended objects: plain locking vs flat combining
+
+static int NextThreadSeed() {
+  static std::atomic<int> next{0};
+  return next.fetch_add(1);
+}
+
+template <typename Guarded>
+static void BM_CounterMap(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static Guarded counters;
+
+  int key = NextThreadSeed() % 64;
+  for (auto _ : state) {
+    counters.WithLock([&](std::map<int, int>& map) {
+      ++map[key];
+    });
+    key = (key + 7) % 64;
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_CounterMap,
+                   solutions::Guarded<std::map<int, int>>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_CounterMap,
+                   solutions::FlatCombiningGuarded<std::map<int, int>>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+template <typename Guarded>
+static void BM_PriorityQueue(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static Guarded queue;
+
+  unsigned value = NextThreadSeed();
+  for (auto _ : state) {
+    // Push, then pop: queue size stays bounded
+    queue.WithLock([&](std::priority_queue<unsigned>& q) {
+      q.push(value);
+    });
+    unsigned top = queue.WithLock([](std::priority_queue<unsigned>& q) {
+      unsigned top = q.top();
+      q.pop();
+      return top;
+    });
+    benchmark::DoNotOptimize(top);
+    value = value * 31 + 17;
+  }
+  state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK_TEMPLATE(BM_PriorityQueue,
+                   solutions::Guarded<std::priority_queue<unsigned>>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_PriorityQueue,
+                   solutions::FlatCombiningGuarded<std::priority_queue<unsigned>>)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,19 +1,362 @@
 #pragma once
 
+#include <twist/stdlike/atomic.hpp>
 #include <twist/stdlike/mutex.hpp>
+#include <twist/strand/spin_wait.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <exception>
+#include <optional>
+#include <type_traits>
+#include <utility>
 
 namespace solutions {
 
+namespace detail {
+
+// Lock policies come in two flavours:
+// - std-like: lock / unlock (+ lock_shared / unlock_shared)
+// - solutions-like: Lock / Unlock (+ LockShared / UnlockShared)
+
+template <typename L, typename = void>
+struct IsStdLike : std::false_type {};
+
+template <typename L>
+struct IsStdLike<L, std::void_t<decltype(std::declval<L&>().lock())>>
+    : std::true_type {};
+
+template <typename L, typename = void>
+struct HasStdShared : std::false_type {};
+
+template <typename L>
+struct HasStdShared<L,
+                    std::void_t<decltype(std::declval<L&>().lock_shared())>>
+    : std::true_type {};
+
+template <typename L, typename = void>
+struct HasShared : std::false_type {};
+
+template <typename L>
+struct HasShared<L, std::void_t<decltype(std::declval<L&>().LockShared())>>
+    : std::true_type {};
+
+}  // namespace detail
+
+template <typename L>
+struct LockTraits {
+  // Readers run in parallel
+  static constexpr bool kShared =
+      detail::HasStdShared<L>::value || detail::HasShared<L>::value;
+
+  static void Lock(L& lock) {
+    if constexpr (detail::IsStdLike<L>::value) {
+      lock.lock();
+    } else {
+      lock.Lock();
+    }
+  }
+
+  static void Unlock(L& lock) {
+    if constexpr (detail::IsStdLike<L>::value) {
+      lock.unlock();
+    } else {
+      lock.Unlock();
+    }
+  }
+
+  // Falls back to exclusive lock
+  static void LockShared(L& lock) {
+    if constexpr (detail::HasStdShared<L>::value) {
+      lock.lock_shared();
+    } else if constexpr (detail::HasShared<L>::value) {
+      lock.LockShared();
+    } else {
+      Lock(lock);
+    }
+  }
+
+  static void UnlockShared(L& lock) {
+    if constexpr (detail::HasStdShared<L>::value) {
+      lock.unlock_shared();
+    } else if constexpr (detail::HasShared<L>::value) {
+      lock.UnlockShared();
+    } else {
+      Unlock(lock);
+    }
+  }
+};
+
+//////////////////////////////////////////////////////////////////////
+
 // Automagically wraps all accesses to guarded object to critical sections
 // Look at unit tests for API and usage examples
-template <typename T>
+
+// guarded->Method();  // One critical section per call
+//
+// {
+//   auto access = guarded.WriteAccess();  // Critical section
+//   access->Method();
+//   access->OtherMethod();
+// }
+//
+// guarded.ReadAccess()->ConstMethod();  // Shared for RW locks
+//
+// guarded.WithLock([](T& object) { ... });  // Batch of operations
+
+template <typename T, typename Lock = twist::stdlike::mutex>
 class Guarded {
-  // Your code goes here
+  using Traits = LockTraits<Lock>;
+
+ public:
+  // Exclusive access to object
+  class WriteHandle {
+   public:
+    explicit WriteHandle(Guarded& owner) : owner_(owner) {
+      Traits::Lock(owner_.lock_);
+    }
+
+    WriteHandle(const WriteHandle&) = delete;
+    WriteHandle& operator=(const WriteHandle&) = delete;
+
+    ~WriteHandle() {
+      Traits::Unlock(owner_.lock_);
+    }
+
+    T* operator->() {
+      return &owner_.object_;
+    }
+
+    T& operator*() {
+      return owner_.object_;
+    }
+
+   private:
+    Guarded& owner_;
+  };
+
+  // Shared (if supported by Lock) read-only access to object
+  class ReadHandle {
+   public:
+    explicit ReadHandle(const Guarded& owner) : owner_(owner) {
+      Traits::LockShared(owner_.lock_);
+    }
+
+    ReadHandle(const ReadHandle&) = delete;
+    ReadHandle& operator=(const ReadHandle&) = delete;
+
+    ~ReadHandle() {
+      Traits::UnlockShared(owner_.lock_);
+    }
+
+    const T* operator->() const {
+      return &owner_.object_;
+    }
+
+    const T& operator*() const {
+      return owner_.object_;
+    }
+
+   private:
+    const Guarded& owner_;
+  };
+
+ public:
+  template <typename... Args>
+  explicit Guarded(Args&&... args) : object_(std::forward<Args>(args)...) {
+  }
+
+  // Temporary handle lives until the end of full expression:
+  // guarded->Method() locks, calls Method, unlocks
+  WriteHandle operator->() {
+    return WriteHandle(*this);
+  }
+
+  ReadHandle operator->() const {
+    return ReadHandle(*this);
+  }
+
+  WriteHandle WriteAccess() {
+    return WriteHandle(*this);
+  }
+
+  ReadHandle ReadAccess() const {
+    return ReadHandle(*this);
+  }
+
+  // Runs f(T&) under single lock acquisition
+  template <typename F>
+  decltype(auto) WithLock(F&& f) {
+    WriteHandle access(*this);
+    return std::forward<F>(f)(*access);
+  }
+
+  // Runs f(const T&) under shared lock
+  template <typename F>
+  decltype(auto) WithLock(F&& f) const {
+    ReadHandle access(*this);
+    return std::forward<F>(f)(*access);
+  }
 
  private:
   T object_;
-  twist::stdlike::mutex mutex_;
+  mutable Lock lock_;
 };
 
-}  // namespace solutions
+//////////////////////////////////////////////////////////////////////
+
+// Flat combining: drop-in replacement of Guarded::WithLock
+// for highly contended objects
+
+// Thread publishes operation in its publication slot, then either
+// waits for completion or becomes combiner: takes the lock and runs
+// all published operations in one pass. Object stays hot in
+// combiner's cache, the lock changes hands once per batch instead
+// of once per operation.
+//
+// Operations run on combiner thread, so they must not depend on
+// thread identity (thread-locals etc). Exception thrown by operation
+// is rethrown from WithLock in the thread that called it
+
+template <typename T>
+class FlatCombiningGuarded {
+  static const size_t kSlots = 64;
+
+  struct Request {
+    void (*run)(Request* self, T& object);
+    // Set by combiner if operation has thrown
+    std::exception_ptr error;
+    twist::stdlike::atomic<bool> done{false};
+  };
+
+  template <typename F, typename R>
+  struct Operation : Request {
+    explicit Operation(F& f) : f(f) {
+      this->run = &Operation::Run;
+    }
+
+    static void Run(Request* self, T& object) {
+      auto* op = static_cast<Operation*>(self);
+      if constexpr (std::is_void_v<R>) {
+        op->f(object);
+      } else {
+        op->result.emplace(op->f(object));
+      }
+    }
+
+    F& f;
+    std::optional<std::conditional_t<std::is_void_v<R>, char, R>> result;
+  };
+
+  struct alignas(64) Slot {
+    twist::stdlike::atomic<Request*> request{nullptr};
+  };
+
+ public:
+  template <typename... Args>
+  explicit FlatCombiningGuarded(Args&&... args)
+      : object_(std::forward<Args>(args)...) {
+  }
+
+  // Runs f(T&) under the lock, maybe on another thread
+  template <typename F>
+  std::invoke_result_t<F&, T&> WithLock(F&& f) {
+    using R = std::invoke_result_t<F&, T&>;
+    static_assert(!std::is_reference_v<R>, "Return result by value");
 
+    Operation<std::remove_reference_t<F>, R> op(f);
+    if (TryLock()) {
+      // Fast path: run own operation, then help others
+      Execute(&op);
+      CombineAndUnlock();
+    } else {
+      Publish(op);
+      WaitOrCombine(op);
+    }
+
+    if (op.error) {
+      std::rethrow_exception(op.error);
+    }
+    if constexpr (!std::is_void_v<R>) {
+      return std::move(*op.result);
+    }
+  }
+
+ private:
+  Slot& MySlot() {
+    static std::atomic<size_t> next_slot{0};
+    static thread_local size_t index = next_slot.fetch_add(1) % kSlots;
+
+    // Combiner scans only slots that were used
+    size_t used = used_slots_.load();
+    while (used <= index &&
+           !used_slots_.compare_exchange_weak(used, index + 1)) {
+    }
+    return slots_[index];
+  }
+
+  void Publish(Request& request) {
+    Slot& slot = MySlot();
+    twist::strand::SpinWait spin_wait;
+    while (true) {
+      Request* empty = nullptr;
+      if (slot.request.compare_exchange_weak(empty, &request)) {
+        return;
+      }
+      // Slot is shared with another thread
+      TryCombine();
+      spin_wait();
+    }
+  }
+
+  void WaitOrCombine(Request& request) {
+    twist::strand::SpinWait spin_wait;
+    while (!request.done.load()) {
+      TryCombine();
+      spin_wait();
+    }
+  }
+
+  bool TryLock() {
+    return !combining_.load() && !combining_.exchange(true);
+  }
+
+  void TryCombine() {
+    if (TryLock()) {
+      CombineAndUnlock();
+    }
+  }
+
+  void CombineAndUnlock() {
+    size_t used = used_slots_.load();
+    for (size_t i = 0; i < used; ++i) {
+      Slot& slot = slots_[i];
+      if (Request* request = slot.request.load()) {
+        Execute(request);
+        slot.request.store(nullptr);
+        // Request lives on the stack of waiting thread,
+        // do not touch it after this point
+        request->done.store(true);
+      }
+    }
+    combining_.store(false);
+  }
+
+  // Never throws: combiner must release slots and combining_
+  // whatever operations do
+  void Execute(Request* request) {
+    try {
+      request->run(request, object_);
+    } catch (...) {
+      request->error = std::current_exception();
+    }
+  }
+
+ private:
+  T object_;
+  Slot slots_[kSlots];
+  alignas(64) twist::stdlike::atomic<size_t> used_slots_{0};
+  alignas(64) twist::stdlike::atomic<bool> combining_{false};
+};
+
+}  // namespace solutions
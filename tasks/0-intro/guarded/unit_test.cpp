@@ -4,8 +4,12 @@
 
 #include <guarded.hpp>
 
+#include <twist/stdlike/atomic.hpp>
+
 #include <chrono>
+#include <memory>
 #include <set>
+#include <stdexcept>
 #include <string>
 #include <vector>
 
@@ -60,4 +64,242 @@ TEST_SUITE(Guarded) {
   }
 }
 
+// Lock policies for tests
+
+class SpinLock {
+ public:
+  void Lock() {
+    while (locked_.exchange(true)) {
+      twist::strand::this_thread::yield();
+    }
+  }
+
+  void Unlock() {
+    locked_.store(false);
+  }
+
+ private:
+  twist::stdlike::atomic<bool> locked_{false};
+};
+
+// Counts acquisitions, checks shared / exclusive mode
+class CountingRWLock {
+ public:
+  void Lock() {
+    ++exclusive;
+    mutex_.lock();
+  }
+
+  void Unlock() {
+    mutex_.unlock();
+  }
+
+  void LockShared() {
+    ++shared;
+    mutex_.lock();
+  }
+
+  void UnlockShared() {
+    mutex_.unlock();
+  }
+
+  static void Reset() {
+    exclusive = 0;
+    shared = 0;
+  }
+
+  static inline size_t exclusive = 0;
+  static inline size_t shared = 0;
+
+ private:
+  twist::stdlike::mutex mutex_;
+};
+
+TEST_SUITE(GuardedLockPolicy) {
+  SIMPLE_T_TEST(SpinLock) {
+    solutions::Guarded<std::vector<int>, SpinLock> vector;
+
+    vector->push_back(1);
+    vector->push_back(2);
+    ASSERT_EQ(vector->size(), 2);
+  }
+
+  SIMPLE_T_TEST(WriteAccess) {
+    solutions::Guarded<std::vector<int>, SpinLock> vector;
+
+    {
+      auto access = vector.WriteAccess();
+      access->push_back(1);
+      access->push_back(2);
+      (*access).push_back(3);
+    }
+
+    ASSERT_EQ(vector->size(), 3);
+  }
+
+  SIMPLE_T_TEST(WithLock) {
+    solutions::Guarded<std::vector<int>> vector;
+
+    size_t size = vector.WithLock([](std::vector<int>& v) {
+      v.push_back(1);
+      v.push_back(2);
+      return v.size();
+    });
+
+    ASSERT_EQ(size, 2);
+  }
+
+  SIMPLE_T_TEST(BatchingTakesLockOnce) {
+    solutions::Guarded<std::vector<int>, CountingRWLock> vector;
+    CountingRWLock::Reset();
+
+    vector.WithLock([](std::vector<int>& v) {
+      for (int i = 0; i < 10; ++i) {
+        v.push_back(i);
+      }
+    });
+
+    {
+      auto access = vector.WriteAccess();
+      access->push_back(10);
+      access->push_back(11);
+    }
+
+    ASSERT_EQ(CountingRWLock::exclusive, 2);
+
+    ASSERT_EQ(vector.ReadAccess()->size(), 12);
+    ASSERT_EQ(CountingRWLock::shared, 1);
+  }
+
+  SIMPLE_T_TEST(SharedReads) {
+    using GuardedVector = solutions::Guarded<std::vector<int>, CountingRWLock>;
+
+    GuardedVector vector;
+    vector->push_back(42);
+    CountingRWLock::Reset();
+
+    const GuardedVector& const_vector = vector;
+    ASSERT_EQ(const_vector->front(), 42);
+    ASSERT_EQ(vector.ReadAccess()->size(), 1);
+    size_t size = const_vector.WithLock([](const std::vector<int>& v) {
+      return v.size();
+    });
+    ASSERT_EQ(size, 1);
+
+    ASSERT_EQ(CountingRWLock::shared, 3);
+    ASSERT_EQ(CountingRWLock::exclusive, 0);
+  }
+
+  SIMPLE_T_TEST(ConstructorArgs) {
+    solutions::Guarded<std::string, SpinLock> string(3, 'x');
+    ASSERT_EQ(*string.ReadAccess(), "xxx");
+  }
+}
+
+TEST_SUITE(FlatCombiningGuarded) {
+  SIMPLE_T_TEST(WithLock) {
+    solutions::FlatCombiningGuarded<std::vector<int>> vector;
+
+    vector.WithLock([](std::vector<int>& v) {
+      v.push_back(1);
+    });
+    size_t size = vector.WithLock([](std::vector<int>& v) {
+      v.push_back(2);
+      return v.size();
+    });
+
+    ASSERT_EQ(size, 2);
+  }
+
+  SIMPLE_T_TEST(MoveOnlyResult) {
+    solutions::FlatCombiningGuarded<std::string> string("Hello");
+
+    auto copy = string.WithLock([](std::string& s) {
+      return std::make_unique<std::string>(s);
+    });
+
+    ASSERT_EQ(*copy, "Hello");
+  }
+
+  SIMPLE_T_TEST(ConcurrentIncrements) {
+    static const size_t kThreads = 4;
+    static const size_t kIncrements = 10000;
+
+    solutions::FlatCombiningGuarded<size_t> counter(0);
+
+    auto routine = [&]() {
+      for (size_t i = 0; i < kIncrements; ++i) {
+        counter.WithLock([](size_t& value) {
+          ++value;
+        });
+      }
+    };
+
+    std::vector<twist::strand::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+      threads.emplace_back(routine);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    size_t value = counter.WithLock([](size_t& value) {
+      return value;
+    });
+    ASSERT_EQ(value, kThreads * kIncrements);
+  }
+
+  SIMPLE_T_TEST(Exception) {
+    solutions::FlatCombiningGuarded<int> value(0);
+
+    ASSERT_THROW(value.WithLock([](int&) -> int {
+      throw std::runtime_error("Test");
+    }), std::runtime_error);
+
+    // Lock is released
+    value.WithLock([](int& v) {
+      ++v;
+    });
+  }
+
+  SIMPLE_T_TEST(ExceptionWhileOthersWait) {
+    static const size_t kThreads = 4;
+    static const size_t kIterations = 10000;
+
+    solutions::FlatCombiningGuarded<size_t> counter(0);
+    twist::stdlike::atomic<size_t> thrown{0};
+
+    auto routine = [&](size_t t) {
+      for (size_t i = 0; i < kIterations; ++i) {
+        bool fail = (t + i) % 3 == 0;
+        try {
+          counter.WithLock([fail](size_t& value) {
+            if (fail) {
+              throw std::runtime_error("Fail");
+            }
+            ++value;
+          });
+        } catch (std::runtime_error&) {
+          // Exception reaches the thread that owns the operation
+          ASSERT_TRUE(fail);
+          thrown.fetch_add(1);
+        }
+      }
+    };
+
+    std::vector<twist::strand::thread> threads;
+    for (size_t t = 0; t < kThreads; ++t) {
+      threads.emplace_back(routine, t);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    size_t value = counter.WithLock([](size_t& value) {
+      return value;
+    });
+    ASSERT_EQ(value + thrown.load(), kThreads * kIterations);
+  }
+}
+
 RUN_ALL_TESTS()
@@ -0,0 +1,40 @@
+#include <benchmark/benchmark.h>
+
+#include "mutex.hpp"
+
+#include <cstdint>
+
+// Short critical sections: parking vs spinning before parking
+// Arguments: critical section size (increments)
+
+static std::uint64_t shared_counter = 0;
+
+template <typename Mutex>
+static void BM_Mutex(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static Mutex mutex;
+
+  const size_t size = state.range(0);
+  for (auto _ : state) {
+    mutex.Lock();
+    for (size_t i = 0; i < size; ++i) {
+      benchmark::DoNotOptimize(++shared_counter);
+    }
+    mutex.Unlock();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK_TEMPLATE(BM_Mutex, solutions::Mutex)
+    ->Arg(1)
+    ->Arg(100)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Mutex, solutions::AdaptiveMutex)
+    ->Arg(1)
+    ->Arg(100)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -4,16 +4,92 @@
 #include <twist/stdlike/atomic.hpp>
 #include <twist/twisted/futex.hpp>
 
+#include <algorithm>
+#include <cstdint>
+
 namespace solutions {
 
 using twist::strand::SpinWait;
 using twist::twisted::Futex;
 
-class Mutex {
+//////////////////////////////////////////////////////////////////////
+
+// Spin policies: what to do on contention before parking in futex
+// Spin(try_lock) returns true iff lock was acquired with try_lock
+
+// Park right away
+class NoSpin {
+ public:
+  template <typename TryLock>
+  bool Spin(TryLock /*try_lock*/) {
+    return false;
+  }
+};
+
+// Spins for a bounded, self-tuning number of iterations
+// (adaptive mutex from glibc, PTHREAD_MUTEX_ADAPTIVE_NP)
+
+// The number of iterations it took to acquire the lock while spinning
+// tracks how long the lock is usually held after we arrive:
+// short critical sections -> few iterations are enough,
+// long critical sections -> spinning fails, budget shrinks to the minimum
+// (unlike glibc, failed spin pulls the estimate down, not up)
+class AdaptiveSpin {
+  static const uint32_t kMinSpins = 10;
+  static const uint32_t kMaxSpins = 100;
+
+ public:
+  template <typename TryLock>
+  bool Spin(TryLock try_lock) {
+    const uint32_t estimate = estimate_.load(std::memory_order_relaxed);
+    const uint32_t budget = std::min(kMaxSpins, estimate * 2 + kMinSpins);
+
+    SpinWait spin_wait;
+    for (uint32_t i = 0; i < budget; ++i) {
+      if (try_lock()) {
+        Update(estimate, i);
+        return true;
+      }
+      spin_wait();
+    }
+    // Spinning did not pay off: spin less next time
+    Update(estimate, 0);
+    return false;
+  }
+
+  uint32_t Estimate() const {
+    return estimate_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Exponential moving average, weight 1/8
+  void Update(uint32_t estimate, uint32_t spins) {
+    int32_t delta = ((int32_t)spins - (int32_t)estimate) / 8;
+    if (delta == 0 && spins != estimate) {
+      // Integer division would stall short of the target
+      delta = (spins > estimate) ? 1 : -1;
+    }
+    estimate_.store(estimate + delta, std::memory_order_relaxed);
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> estimate_{0};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Three-state futex mutex
+// 0 - unlocked, 1 - locked, no waiters, 2 - locked, maybe has waiters
+
+template <typename SpinPolicy>
+class BasicMutex {
  public:
   void Lock() {
     int c;
     if ((c = Cmpxchg(0, 1)) != 0) {
+      if (spin_policy_.Spin([this]() { return TryLock(); })) {
+        return;
+      }
       if (c != 2) {
         c = Xchg(2);
       }
@@ -24,6 +100,10 @@ class Mutex {
     }
   }
 
+  bool TryLock() {
+    return state_.load() == 0 && Cmpxchg(0, 1) == 0;
+  }
+
   void Unlock() {
     // Your code goes here
     if (Xchg(0) == 2) {
@@ -43,6 +123,13 @@ class Mutex {
  private:
   twist::stdlike::atomic<uint32_t> state_{0};
   Futex futex_{state_};
+  SpinPolicy spin_policy_;
 };
 
+// Classic futex mutex: parks on the first contention
+using Mutex = BasicMutex<NoSpin>;
+
+// Spins before parking, for short critical sections
+using AdaptiveMutex = BasicMutex<AdaptiveSpin>;
+
 }  // namespace solutions
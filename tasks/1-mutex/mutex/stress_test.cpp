@@ -18,6 +18,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace stress {
+  template <typename Mutex>
   class Tester {
    public:
     Tester(const TTestParameters& parameters)
@@ -55,13 +56,17 @@ namespace stress {
     TTestParameters parameters_;
     twist::test_utils::OnePassBarrier start_barrier_;
     std::atomic<bool> in_critical_section_{false};
-    solutions::Mutex mutex_;
+    Mutex mutex_;
   };
 
 };
 
 void StressTest(TTestParameters parameters) {
-  stress::Tester(parameters).Run();
+  stress::Tester<solutions::Mutex>(parameters).Run();
+}
+
+void AdaptiveStressTest(TTestParameters parameters) {
+  stress::Tester<solutions::AdaptiveMutex>(parameters).Run();
 }
 
 // Parameters: threads, iterations
@@ -71,6 +76,11 @@ T_TEST_CASES(StressTest)
   .Case({2, 100000})
   .Case({10, 100000});
 
+T_TEST_CASES(AdaptiveStressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({2, 100000})
+  .Case({10, 100000});
+
 #if defined(TWIST_FIBER)
 
 T_TEST_CASES(StressTest)
@@ -83,8 +93,9 @@ T_TEST_CASES(StressTest)
 
 namespace wakeup {
 
+template <typename Mutex>
 void Test(size_t threads) {
-  solutions::Mutex mutex;
+  Mutex mutex;
   twist::test_utils::OnePassBarrier barrier{threads};
 
   auto contender = [&]() {
@@ -107,7 +118,8 @@ void MissedWakeupTest(TTestParameters parameters) {
   size_t iterations = parameters.Get(1);
  
   for (size_t i = 0; i < iterations; ++i) {
-    wakeup::Test(threads);
+    wakeup::Test<solutions::Mutex>(threads);
+    wakeup::Test<solutions::AdaptiveMutex>(threads);
   }
 }
 
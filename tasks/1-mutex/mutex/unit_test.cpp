@@ -132,4 +132,107 @@ TEST_SUITE(UnitTest) {
 
 }
 
+TEST_SUITE(AdaptiveMutex) {
+  SIMPLE_T_TEST(LockUnlock) {
+    solutions::AdaptiveMutex mutex;
+    mutex.Lock();
+    mutex.Unlock();
+  }
+
+  SIMPLE_T_TEST(TryLock) {
+    solutions::AdaptiveMutex mutex;
+    ASSERT_TRUE(mutex.TryLock());
+    ASSERT_FALSE(mutex.TryLock());
+    mutex.Unlock();
+    mutex.Lock();
+    ASSERT_FALSE(mutex.TryLock());
+    mutex.Unlock();
+  }
+
+  SIMPLE_T_TEST(ConcurrentLock) {
+    solutions::AdaptiveMutex mutex;
+
+    volatile int counter = 0;
+
+    auto routine = [&mutex, &counter]() {
+      mutex.Lock();
+      twist::strand::this_thread::sleep_for(100ms);
+      counter++;
+      mutex.Unlock();
+    };
+
+    twist::test_utils::ScopedExecutor executor;
+    executor.Submit(routine);
+    executor.Submit(routine);
+    executor.Join();
+
+    ASSERT_EQ(2, counter);
+  }
+
+  SIMPLE_T_TEST(SpinEstimateFollowsHoldTime) {
+    solutions::AdaptiveSpin spin;
+
+    // Short holds: lock is acquired after a few iterations
+    for (size_t i = 0; i < 100; ++i) {
+      size_t attempts = 0;
+      ASSERT_TRUE(spin.Spin([&]() {
+        return ++attempts > 8;
+      }));
+    }
+    uint32_t short_estimate = spin.Estimate();
+    ASSERT_TRUE(short_estimate > 0);
+
+    // Long holds: spinning always fails
+    for (size_t i = 0; i < 100; ++i) {
+      ASSERT_FALSE(spin.Spin([]() {
+        return false;
+      }));
+    }
+    ASSERT_TRUE(spin.Estimate() < short_estimate);
+    ASSERT_EQ(spin.Estimate(), 0u);
+  }
+
+#if !defined(TWIST_FIBER)
+
+  SIMPLE_T_TEST(ParkOnLongCriticalSection) {
+    solutions::AdaptiveMutex mutex;
+
+    twist::strand::thread sleeper([&]() {
+      mutex.Lock();
+      twist::strand::this_thread::sleep_for(3s);
+      mutex.Unlock();
+    });
+
+    twist::strand::thread waiter([&]() {
+      twist::strand::this_thread::sleep_for(1s);
+      CPUTimer timer;
+      mutex.Lock();
+      mutex.Unlock();
+      double running_time = timer.RunningTime();
+      std::cout << "Lock/Unlock cpu time in waiter thread: " << running_time << " seconds\n";
+      ASSERT_TRUE(running_time < 0.1);
+    });
+
+    sleeper.join();
+    waiter.join();
+  }
+
+  SIMPLE_T_TEST(NoContentionNoFutexes) {
+    static const size_t kNoContentionIterations = 1000;
+
+    size_t futex_calls = twist::thread::FutexCallCount();
+
+    solutions::AdaptiveMutex mutex;
+    for (size_t i = 0; i < kNoContentionIterations; ++i) {
+      mutex.Lock();
+      mutex.Unlock();
+    }
+
+    ASSERT_EQ(futex_calls, twist::thread::FutexCallCount());
+  }
+
+#endif
+
+}
+
 RUN_ALL_TESTS()
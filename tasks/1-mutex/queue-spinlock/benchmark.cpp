@@ -0,0 +1,65 @@
+#include <benchmark/benchmark.h>
+
+#include "queue_spinlock.hpp"
+
+#include "spinlock.hpp"
+#include "ticket_lock.hpp"
+
+#include <cstdint>
+
+// TTAS vs Ticket vs MCS locks
+// Arguments: critical section size (cache lines written)
+
+static const size_t kMaxCriticalSection = 64;
+
+struct alignas(64) CacheLine {
+  std::uint64_t value = 0;
+};
+
+// Data protected by lock
+static CacheLine shared_data[kMaxCriticalSection];
+
+static void CriticalSection(size_t size) {
+  for (size_t i = 0; i < size; ++i) {
+    benchmark::DoNotOptimize(++shared_data[i].value);
+  }
+}
+
+template <typename Lock>
+static void LockAndRun(Lock& lock, size_t size) {
+  lock.Lock();
+  CriticalSection(size);
+  lock.Unlock();
+}
+
+static void LockAndRun(solutions::QueueSpinLock& lock, size_t size) {
+  solutions::QueueSpinLock::Guard guard(lock);
+  CriticalSection(size);
+}
+
+template <typename Lock>
+static void BM_Lock(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static Lock lock;
+
+  const size_t size = state.range(0);
+  for (auto _ : state) {
+    LockAndRun(lock, size);
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define LOCK_BENCHMARK(Lock)        \
+  BENCHMARK_TEMPLATE(BM_Lock, Lock) \
+      ->Arg(1)                      \
+      ->Arg(8)                      \
+      ->Arg(kMaxCriticalSection)    \
+      ->ThreadRange(1, 32)          \
+      ->UseRealTime()
+
+LOCK_BENCHMARK(solutions::SpinLock<solutions::SpinWaitBackoff>);
+LOCK_BENCHMARK(solutions::SpinLock<solutions::ExponentialBackoff>);
+LOCK_BENCHMARK(solutions::TicketLock);
+LOCK_BENCHMARK(solutions::QueueSpinLock);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/strand/spin_wait.hpp>
+
+#include <cstddef>
+
+namespace solutions {
+
+using twist::strand::SpinWait;
+
+// MCS queue spinlock
+// https://www.cs.rochester.edu/u/scott/papers/1991_TOCS_synch.pdf
+
+// Waiters form a linked queue of nodes, each waiter spins on
+// its own node, so Unlock touches only the cache line
+// of the next waiter instead of invalidating all of them
+
+class QueueSpinLock {
+  static const size_t kCacheLineSize = 64;
+
+ public:
+  // Scoped lock ownership, also a node in the queue of waiters
+  class alignas(kCacheLineSize) Guard {
+    friend class QueueSpinLock;
+
+   public:
+    explicit Guard(QueueSpinLock& spinlock) : spinlock_(spinlock) {
+      spinlock_.Acquire(this);
+    }
+
+    // Non-copyable, non-movable: address of the node is published
+    Guard(const Guard& that) = delete;
+    Guard& operator=(const Guard& that) = delete;
+
+    ~Guard() {
+      spinlock_.Release(this);
+    }
+
+   private:
+    QueueSpinLock& spinlock_;
+    twist::stdlike::atomic<Guard*> next_{nullptr};
+    twist::stdlike::atomic<bool> is_owner_{false};
+  };
+
+  bool IsLocked() const {
+    return tail_.load() != nullptr;
+  }
+
+ private:
+  void Acquire(Guard* waiter) {
+    Guard* prev = tail_.exchange(waiter, std::memory_order_acq_rel);
+    if (prev == nullptr) {
+      return;  // Uncontended
+    }
+
+    prev->next_.store(waiter, std::memory_order_release);
+
+    // Spin on our own cache line
+    SpinWait spin_wait;
+    while (!waiter->is_owner_.load(std::memory_order_acquire)) {
+      spin_wait();
+    }
+  }
+
+  void Release(Guard* owner) {
+    Guard* next = owner->next_.load(std::memory_order_acquire);
+
+    if (next == nullptr) {
+      // No known successor: try to reset tail
+      Guard* expected = owner;
+      if (tail_.compare_exchange_strong(expected, nullptr,
+                                        std::memory_order_release,
+                                        std::memory_order_relaxed)) {
+        return;
+      }
+      // Successor has already swapped tail, wait until it links itself
+      SpinWait spin_wait;
+      while ((next = owner->next_.load(std::memory_order_acquire)) ==
+             nullptr) {
+        spin_wait();
+      }
+    }
+
+    next->is_owner_.store(true, std::memory_order_release);
+  }
+
+ private:
+  alignas(kCacheLineSize) twist::stdlike::atomic<Guard*> tail_{nullptr};
+};
+
+}  // namespace solutions
@@ -0,0 +1,74 @@
+#include "queue_spinlock.hpp"
+
+#include <twist/test_framework/test_framework.hpp>
+#include <twist/strand/test.hpp>
+
+#include <twist/test_utils/executor.hpp>
+
+#include <chrono>
+
+using namespace std::chrono_literals;
+
+using solutions::QueueSpinLock;
+
+TEST_SUITE(QueueSpinLock) {
+  SIMPLE_T_TEST(LockUnlock) {
+    QueueSpinLock spinlock;
+    {
+      QueueSpinLock::Guard guard(spinlock);
+      ASSERT_TRUE(spinlock.IsLocked());
+    }
+    ASSERT_FALSE(spinlock.IsLocked());
+  }
+
+  SIMPLE_T_TEST(SequentialLockUnlock) {
+    QueueSpinLock spinlock;
+    {
+      QueueSpinLock::Guard guard(spinlock);
+    }
+    {
+      QueueSpinLock::Guard guard(spinlock);
+    }
+  }
+
+  SIMPLE_T_TEST(NestedLocks) {
+    QueueSpinLock first;
+    QueueSpinLock second;
+
+    QueueSpinLock::Guard first_guard(first);
+    {
+      QueueSpinLock::Guard second_guard(second);
+      ASSERT_TRUE(second.IsLocked());
+    }
+    ASSERT_FALSE(second.IsLocked());
+    ASSERT_TRUE(first.IsLocked());
+  }
+
+  SIMPLE_T_TEST(NodeAlignment) {
+    ASSERT_EQ(alignof(QueueSpinLock::Guard), 64);
+  }
+
+  SIMPLE_T_TEST(Waiters) {
+    QueueSpinLock spinlock;
+    volatile size_t counter = 0;
+
+    static const size_t kWaiters = 3;
+
+    auto routine = [&]() {
+      QueueSpinLock::Guard guard(spinlock);
+      twist::strand::this_thread::sleep_for(50ms);
+      counter = counter + 1;
+    };
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t i = 0; i < kWaiters; ++i) {
+      executor.Submit(routine);
+    }
+    executor.Join();
+
+    ASSERT_EQ(counter, kWaiters);
+    ASSERT_FALSE(spinlock.IsLocked());
+  }
+}
+
+RUN_ALL_TESTS()
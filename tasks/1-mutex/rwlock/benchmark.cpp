@@ -0,0 +1,79 @@
+#include <benchmark/benchmark.h>
+
+#include "shared_mutex.hpp"
+#include "distributed_shared_mutex.hpp"
+#include "brlock.hpp"
+
+#include <twist/stdlike/mutex.hpp>
+
+#include <cstdint>
+
+// Read-mostly workload: exclusive mutex vs reader-writer locks
+// Arguments: percentage of reads
+
+// Exclusive lock as reader-writer lock
+class ExclusiveMutex {
+ public:
+  void Lock() {
+    mutex_.lock();
+  }
+
+  void Unlock() {
+    mutex_.unlock();
+  }
+
+  void LockShared() {
+    mutex_.lock();
+  }
+
+  void UnlockShared() {
+    mutex_.unlock();
+  }
+
+ private:
+  twist::stdlike::mutex mutex_;
+};
+
+static std::uint64_t shared_data[8];
+
+template <typename SharedMutex>
+static void BM_ReadRatio(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static SharedMutex mutex;
+
+  const uint32_t read_ratio = state.range(0);
+  uint32_t iteration = 0;
+
+  for (auto _ : state) {
+    if (++iteration % 100 < read_ratio) {
+      mutex.LockShared();
+      for (auto& value : shared_data) {
+        benchmark::DoNotOptimize(value);
+      }
+      mutex.UnlockShared();
+    } else {
+      mutex.Lock();
+      for (auto& value : shared_data) {
+        benchmark::DoNotOptimize(++value);
+      }
+      mutex.Unlock();
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+#define READ_RATIO_BENCHMARK(SharedMutex)      \
+  BENCHMARK_TEMPLATE(BM_ReadRatio, SharedMutex) \
+      ->Arg(50)                                 \
+      ->Arg(90)                                 \
+      ->Arg(99)                                 \
+      ->Arg(100)                                \
+      ->ThreadRange(1, 16)                      \
+      ->UseRealTime()
+
+READ_RATIO_BENCHMARK(ExclusiveMutex);
+READ_RATIO_BENCHMARK(solutions::SharedMutex);
+READ_RATIO_BENCHMARK(solutions::DistributedSharedMutex);
+READ_RATIO_BENCHMARK(solutions::BRLock);
+
+BENCHMARK_MAIN();
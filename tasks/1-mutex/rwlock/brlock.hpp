@@ -0,0 +1,193 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/twisted/futex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace solutions {
+
+using twist::twisted::Futex;
+
+// "Big reader" lock
+
+// One small futex lock per thread slot, padded to cache line.
+// Reader locks only its own slot: uncontended CAS on cache line that
+// no other core writes to. Writer locks all slots in order.
+//
+// Threads are bound to slots on first use (round-robin). If there are
+// more threads than slots, some threads share slot and their read
+// sections are serialized.
+// Read sections do not nest
+
+class BRLock {
+  static const size_t kSlots = 64;
+
+  // Slot states
+  enum State : uint32_t {
+    kFree = 0,
+    kReader = 1,
+    kWriter = 2,
+    kWaiters = 4,  // Flag
+  };
+
+  struct alignas(64) Slot {
+    twist::stdlike::atomic<uint32_t> state{kFree};
+    Futex futex{state};
+  };
+
+ public:
+  // Exclusive access
+
+  void Lock() {
+    for (auto& slot : slots_) {
+      LockSlot(slot, kWriter);
+    }
+  }
+
+  void Unlock() {
+    for (size_t i = kSlots; i > 0; --i) {
+      UnlockSlot(slots_[i - 1]);
+    }
+  }
+
+  // Shared access
+
+  void LockShared() {
+    LockSlot(MySlot(), kReader);
+  }
+
+  void UnlockShared() {
+    UnlockSlot(MySlot());
+  }
+
+ private:
+  Slot& MySlot() {
+    static std::atomic<size_t> next_slot{0};
+    static thread_local size_t index = next_slot.fetch_add(1) % kSlots;
+    return slots_[index];
+  }
+
+  static void LockSlot(Slot& slot, State mode) {
+    uint32_t state = kFree;
+    if (slot.state.compare_exchange_strong(state, mode)) {
+      return;  // Fast path
+    }
+    LockSlotSlow(slot, mode);
+  }
+
+  static void LockSlotSlow(Slot& slot, State mode) {
+    uint32_t state = slot.state.load();
+    while (true) {
+      if (state == kFree) {
+        // Other threads may still wait for this slot
+        if (slot.state.compare_exchange_weak(state, mode | kWaiters)) {
+          return;
+        }
+        continue;
+      }
+      if (!(state & kWaiters)) {
+        if (!slot.state.compare_exchange_weak(state, state | kWaiters)) {
+          continue;
+        }
+        state |= kWaiters;
+      }
+      slot.futex.Wait(state);
+      state = slot.state.load();
+    }
+  }
+
+  static void UnlockSlot(Slot& slot) {
+    if (slot.state.exchange(kFree) & kWaiters) {
+      // Both readers and writers
+      slot.futex.WakeAll();
+    }
+  }
+
+ private:
+  Slot slots_[kSlots];
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Wraps read-mostly object, all accesses go through BRLock
+
+// ReadMostly<RoutingTable> table;
+// table.Read()->Lookup(address);  // Shared access, const
+// table.Write()->Update(route);  // Exclusive access
+
+template <typename T>
+class ReadMostly {
+ public:
+  class ReadGuard {
+   public:
+    explicit ReadGuard(const ReadMostly& owner) : owner_(owner) {
+      owner_.lock_.LockShared();
+    }
+
+    ReadGuard(const ReadGuard&) = delete;
+    ReadGuard& operator=(const ReadGuard&) = delete;
+
+    ~ReadGuard() {
+      owner_.lock_.UnlockShared();
+    }
+
+    const T* operator->() const {
+      return &owner_.object_;
+    }
+
+    const T& operator*() const {
+      return owner_.object_;
+    }
+
+   private:
+    const ReadMostly& owner_;
+  };
+
+  class WriteGuard {
+   public:
+    explicit WriteGuard(ReadMostly& owner) : owner_(owner) {
+      owner_.lock_.Lock();
+    }
+
+    WriteGuard(const WriteGuard&) = delete;
+    WriteGuard& operator=(const WriteGuard&) = delete;
+
+    ~WriteGuard() {
+      owner_.lock_.Unlock();
+    }
+
+    T* operator->() {
+      return &owner_.object_;
+    }
+
+    T& operator*() {
+      return owner_.object_;
+    }
+
+   private:
+    ReadMostly& owner_;
+  };
+
+ public:
+  template <typename... Args>
+  explicit ReadMostly(Args&&... args) : object_(std::forward<Args>(args)...) {
+  }
+
+  ReadGuard Read() const {
+    return ReadGuard(*this);
+  }
+
+  WriteGuard Write() {
+    return WriteGuard(*this);
+  }
+
+ private:
+  T object_;
+  mutable BRLock lock_;
+};
+
+}  // namespace solutions
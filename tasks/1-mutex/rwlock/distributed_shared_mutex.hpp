@@ -0,0 +1,138 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/twisted/futex.hpp>
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace solutions {
+
+using twist::twisted::Futex;
+
+// Reader-writer lock for read-mostly data
+
+// Reader count is distributed over cache-line-padded slots,
+// thread is bound to slot on first use (round-robin).
+// Readers on different slots don't touch shared cache lines
+// (only read the writer flag), writers sweep all slots.
+//
+// Writer sets the flag, then waits until all slots drain;
+// reader increments its slot, then checks the flag and backs off
+// if writer is present (Dekker-style, seq_cst on both sides).
+
+class DistributedSharedMutex {
+  static const size_t kSlots = 16;
+
+  // writer_ states
+  enum WriterState : uint32_t {
+    kFree = 0,
+    kLocked = 1,
+    kLockedWithWaiters = 2,
+  };
+
+  struct alignas(64) Slot {
+    twist::stdlike::atomic<uint32_t> readers{0};
+  };
+
+ public:
+  // Exclusive access
+
+  void Lock() {
+    LockWriter();
+    WaitReaders();
+  }
+
+  void Unlock() {
+    if (writer_.exchange(kFree) == kLockedWithWaiters) {
+      // Both readers and writers
+      writer_futex_.WakeAll();
+    }
+  }
+
+  // Shared access
+
+  void LockShared() {
+    Slot& slot = MySlot();
+    while (true) {
+      slot.readers.fetch_add(1);
+      if (writer_.load() == kFree) {
+        return;
+      }
+      // Writer is present: back off and wait
+      Leave(slot);
+      WaitWriter();
+    }
+  }
+
+  void UnlockShared() {
+    Leave(MySlot());
+  }
+
+ private:
+  Slot& MySlot() {
+    static std::atomic<size_t> next_slot{0};
+    static thread_local size_t index = next_slot.fetch_add(1) % kSlots;
+    return slots_[index];
+  }
+
+  void Leave(Slot& slot) {
+    slot.readers.fetch_sub(1);
+    if (writer_.load() != kFree) {
+      // Writer may wait for this slot to drain
+      drain_seq_.fetch_add(1);
+      drain_futex_.WakeOne();
+    }
+  }
+
+  void LockWriter() {
+    uint32_t state = kFree;
+    if (writer_.compare_exchange_strong(state, kLocked)) {
+      return;
+    }
+    if (state != kLockedWithWaiters) {
+      state = writer_.exchange(kLockedWithWaiters);
+    }
+    while (state != kFree) {
+      writer_futex_.Wait(kLockedWithWaiters);
+      state = writer_.exchange(kLockedWithWaiters);
+    }
+  }
+
+  void WaitWriter() {
+    uint32_t state = writer_.load();
+    while (state != kFree) {
+      if (state == kLocked &&
+          !writer_.compare_exchange_weak(state, kLockedWithWaiters)) {
+        continue;
+      }
+      writer_futex_.Wait(kLockedWithWaiters);
+      state = writer_.load();
+    }
+  }
+
+  // Only one writer at a time
+  void WaitReaders() {
+    for (auto& slot : slots_) {
+      while (true) {
+        uint32_t seq = drain_seq_.load();
+        if (slot.readers.load() == 0) {
+          break;
+        }
+        drain_futex_.Wait(seq);
+      }
+    }
+  }
+
+ private:
+  Slot slots_[kSlots];
+
+  alignas(64) twist::stdlike::atomic<uint32_t> writer_{kFree};
+  Futex writer_futex_{writer_};
+
+  alignas(64) twist::stdlike::atomic<uint32_t> drain_seq_{0};
+  Futex drain_futex_{drain_seq_};
+};
+
+}  // namespace solutions
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/twisted/futex.hpp>
+
+#include <cstdint>
+
+namespace solutions {
+
+using twist::twisted::Futex;
+
+// Writer-preferring reader-writer lock
+
+// State of the lock is a single 32-bit word:
+// - bits 0-19: number of readers holding the lock
+// - bits 20-29: number of writers waiting for the lock
+// - bit 30: lock is held by writer
+// - bit 31: readers are parked in futex
+//
+// Readers park on the state word, writers park on separate
+// sequence word, so Unlock can wake exactly one writer.
+// Uncontended LockShared / UnlockShared / Lock / Unlock
+// don't make syscalls
+
+class SharedMutex {
+  static const uint32_t kReader = 1;
+  static const uint32_t kReadersMask = (1u << 20) - 1;
+
+  static const uint32_t kWaitingWriter = 1u << 20;
+  static const uint32_t kWaitingWritersMask = ((1u << 10) - 1) << 20;
+
+  static const uint32_t kWriter = 1u << 30;
+  static const uint32_t kReadersWaiting = 1u << 31;
+
+ public:
+  // Exclusive access
+
+  void Lock() {
+    uint32_t expected = 0;
+    if (state_.compare_exchange_strong(expected, kWriter)) {
+      return;  // Fast path
+    }
+    LockSlow();
+  }
+
+  bool TryLock() {
+    uint32_t state = state_.load();
+    while (IsFree(state) && !HasWaitingWriters(state)) {
+      if (state_.compare_exchange_weak(state, state | kWriter)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void Unlock() {
+    uint32_t state = state_.fetch_sub(kWriter) - kWriter;
+    if (HasWaitingWriters(state)) {
+      // Writers first
+      WakeWriter();
+    } else if (state & kReadersWaiting) {
+      WakeReaders();
+    }
+  }
+
+  // Shared access
+
+  void LockShared() {
+    uint32_t state = state_.load();
+    while (true) {
+      if (IsReadLockable(state)) {
+        if (state_.compare_exchange_weak(state, state + kReader)) {
+          return;
+        }
+        continue;
+      }
+
+      // Writer holds the lock or waits for it: park
+      if (!(state & kReadersWaiting)) {
+        if (!state_.compare_exchange_weak(state, state | kReadersWaiting)) {
+          continue;
+        }
+        state |= kReadersWaiting;
+      }
+      state_futex_.Wait(state);
+      state = state_.load();
+    }
+  }
+
+  bool TryLockShared() {
+    uint32_t state = state_.load();
+    while (IsReadLockable(state)) {
+      if (state_.compare_exchange_weak(state, state + kReader)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  void UnlockShared() {
+    uint32_t state = state_.fetch_sub(kReader) - kReader;
+    if ((state & kReadersMask) == 0 && HasWaitingWriters(state)) {
+      // Last reader wakes writer
+      WakeWriter();
+    }
+  }
+
+ private:
+  static bool IsFree(uint32_t state) {
+    return (state & (kReadersMask | kWriter)) == 0;
+  }
+
+  static bool HasWaitingWriters(uint32_t state) {
+    return (state & kWaitingWritersMask) != 0;
+  }
+
+  // Writer preference: new readers wait for waiting writers
+  static bool IsReadLockable(uint32_t state) {
+    return (state & (kWriter | kWaitingWritersMask)) == 0 &&
+           (state & kReadersMask) != kReadersMask;
+  }
+
+  void LockSlow() {
+    state_.fetch_add(kWaitingWriter);
+
+    while (true) {
+      // Read sequence before checking the state: wake up after
+      // the check changes the sequence and Wait returns immediately
+      uint32_t seq = writers_seq_.load();
+
+      uint32_t state = state_.load();
+      while (IsFree(state)) {
+        if (state_.compare_exchange_weak(state,
+                                         state - kWaitingWriter + kWriter)) {
+          return;
+        }
+      }
+
+      writers_futex_.Wait(seq);
+    }
+  }
+
+  void WakeWriter() {
+    writers_seq_.fetch_add(1);
+    writers_futex_.WakeOne();
+  }
+
+  void WakeReaders() {
+    // Parked readers will set the flag again if they have to wait
+    if (state_.fetch_and(~kReadersWaiting) & kReadersWaiting) {
+      state_futex_.WakeAll();
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> state_{0};
+  Futex state_futex_{state_};
+
+  twist::stdlike::atomic<uint32_t> writers_seq_{0};
+  Futex writers_futex_{writers_seq_};
+};
+
+}  // namespace solutions
@@ -0,0 +1,184 @@
+#include "shared_mutex.hpp"
+#include "distributed_shared_mutex.hpp"
+#include "brlock.hpp"
+
+#include <twist/fault/adversary/adversary.hpp>
+#include <twist/fault/adversary/inject_fault.hpp>
+
+#include <twist/test_framework/test_framework.hpp>
+#include <twist/strand/test.hpp>
+
+#include <twist/test_utils/barrier.hpp>
+#include <twist/test_utils/executor.hpp>
+
+#include <atomic>
+#include <chrono>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace stress {
+  template <typename SharedMutex>
+  class Tester {
+   public:
+    Tester(const TTestParameters& parameters)
+        : parameters_(parameters),
+          start_barrier_(parameters.Get(0) + parameters.Get(1)) {
+    }
+
+    // One-shot
+    void Run() {
+      twist::test_utils::ScopedExecutor executor;
+      for (size_t t = 0; t < parameters_.Get(0); ++t) {
+        executor.Submit(&Tester::RunWriterThread, this);
+      }
+      for (size_t t = 0; t < parameters_.Get(1); ++t) {
+        executor.Submit(&Tester::RunReaderThread, this);
+      }
+    }
+
+   private:
+    void RunWriterThread() {
+      start_barrier_.PassThrough();
+
+      size_t iterations = parameters_.Get(2);
+      for (size_t i = 0; i < iterations; ++i) {
+        mutex_.Lock();
+        WriteSection();
+        mutex_.Unlock();
+      }
+    }
+
+    void RunReaderThread() {
+      start_barrier_.PassThrough();
+
+      size_t iterations = parameters_.Get(2);
+      for (size_t i = 0; i < iterations; ++i) {
+        mutex_.LockShared();
+        ReadSection();
+        mutex_.UnlockShared();
+      }
+    }
+
+    void WriteSection() {
+      ASSERT_FALSE(writer_.exchange(true));
+      ASSERT_EQ(readers_.load(), 0);
+      twist::fault::InjectFault();
+      ASSERT_EQ(readers_.load(), 0);
+      ASSERT_TRUE(writer_.exchange(false));
+    }
+
+    void ReadSection() {
+      readers_.fetch_add(1);
+      ASSERT_FALSE(writer_.load());
+      twist::fault::InjectFault();
+      ASSERT_FALSE(writer_.load());
+      readers_.fetch_sub(1);
+    }
+
+   private:
+    TTestParameters parameters_;
+    twist::test_utils::OnePassBarrier start_barrier_;
+    std::atomic<bool> writer_{false};
+    std::atomic<size_t> readers_{0};
+    SharedMutex mutex_;
+  };
+
+}  // namespace stress
+
+void StressTest(TTestParameters parameters) {
+  stress::Tester<solutions::SharedMutex>(parameters).Run();
+}
+
+void DistributedStressTest(TTestParameters parameters) {
+  stress::Tester<solutions::DistributedSharedMutex>(parameters).Run();
+}
+
+void BRLockStressTest(TTestParameters parameters) {
+  stress::Tester<solutions::BRLock>(parameters).Run();
+}
+
+// Parameters: writers, readers, iterations
+
+T_TEST_CASES(StressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({1, 4, 50000})
+  .Case({2, 2, 50000})
+  .Case({4, 8, 20000});
+
+T_TEST_CASES(DistributedStressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({1, 4, 50000})
+  .Case({2, 2, 50000})
+  .Case({4, 8, 20000});
+
+T_TEST_CASES(BRLockStressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({1, 4, 50000})
+  .Case({2, 2, 20000})
+  .Case({4, 8, 10000});
+
+#if defined(TWIST_FIBER)
+
+T_TEST_CASES(StressTest)
+  .TimeLimit(std::chrono::seconds(30))
+  .Case({3, 10, 100000});
+
+T_TEST_CASES(DistributedStressTest)
+  .TimeLimit(std::chrono::seconds(30))
+  .Case({3, 10, 100000});
+
+T_TEST_CASES(BRLockStressTest)
+  .TimeLimit(std::chrono::seconds(30))
+  .Case({3, 10, 10000});
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace wakeup {
+
+template <typename SharedMutex>
+void Test(size_t threads) {
+  SharedMutex mutex;
+  twist::test_utils::OnePassBarrier barrier{threads};
+
+  auto contender = [&](size_t index) {
+    barrier.PassThrough();
+
+    if (index % 2 == 0) {
+      mutex.Lock();
+      mutex.Unlock();
+    } else {
+      mutex.LockShared();
+      mutex.UnlockShared();
+    }
+  };
+
+  twist::test_utils::ScopedExecutor executor;
+  for (size_t i = 0; i < threads; ++i) {
+    executor.Submit(contender, i);
+  }
+}
+
+}  // namespace wakeup
+
+void MissedWakeupTest(TTestParameters parameters) {
+  size_t threads = parameters.Get(0);
+  size_t iterations = parameters.Get(1);
+
+  for (size_t i = 0; i < iterations; ++i) {
+    wakeup::Test<solutions::SharedMutex>(threads);
+    wakeup::Test<solutions::DistributedSharedMutex>(threads);
+    wakeup::Test<solutions::BRLock>(threads);
+  }
+}
+
+T_TEST_CASES(MissedWakeupTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({2, 1000})
+  .Case({3, 1000})
+  .Case({4, 1000});
+
+////////////////////////////////////////////////////////////////////////////////
+
+RUN_ALL_TESTS()
@@ -0,0 +1,310 @@
+#include "shared_mutex.hpp"
+#include "distributed_shared_mutex.hpp"
+#include "brlock.hpp"
+
+#include <twist/test_framework/test_framework.hpp>
+#include <twist/strand/test.hpp>
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/test_utils/executor.hpp>
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+using namespace std::chrono_literals;
+
+template <typename SharedMutex>
+void CheckLockUnlock() {
+  SharedMutex mutex;
+  mutex.Lock();
+  mutex.Unlock();
+  mutex.LockShared();
+  mutex.UnlockShared();
+  mutex.Lock();
+  mutex.Unlock();
+}
+
+// Readers don't block each other
+template <typename SharedMutex>
+void CheckConcurrentReaders() {
+  SharedMutex mutex;
+  twist::stdlike::atomic<size_t> readers{0};
+
+  auto reader = [&]() {
+    mutex.LockShared();
+    readers.fetch_add(1);
+    while (readers.load() < 2) {
+      twist::strand::this_thread::yield();
+    }
+    mutex.UnlockShared();
+  };
+
+  twist::test_utils::ScopedExecutor executor;
+  executor.Submit(reader);
+  executor.Submit(reader);
+  executor.Join();
+
+  ASSERT_EQ(readers.load(), 2);
+}
+
+template <typename SharedMutex>
+void CheckWriterExcludesReaders() {
+  SharedMutex mutex;
+  twist::stdlike::atomic<bool> written{false};
+
+  mutex.Lock();
+
+  twist::strand::thread reader([&]() {
+    mutex.LockShared();
+    ASSERT_TRUE(written.load());
+    mutex.UnlockShared();
+  });
+
+  twist::strand::this_thread::sleep_for(100ms);
+  written.store(true);
+  mutex.Unlock();
+
+  reader.join();
+}
+
+template <typename SharedMutex>
+void CheckReadersExcludeWriter() {
+  SharedMutex mutex;
+  twist::stdlike::atomic<bool> read{false};
+
+  mutex.LockShared();
+
+  twist::strand::thread writer([&]() {
+    mutex.Lock();
+    ASSERT_TRUE(read.load());
+    mutex.Unlock();
+  });
+
+  twist::strand::this_thread::sleep_for(100ms);
+  read.store(true);
+  mutex.UnlockShared();
+
+  writer.join();
+}
+
+TEST_SUITE(SharedMutex) {
+  SIMPLE_T_TEST(LockUnlock) {
+    CheckLockUnlock<solutions::SharedMutex>();
+  }
+
+  SIMPLE_T_TEST(TryLock) {
+    solutions::SharedMutex mutex;
+    ASSERT_TRUE(mutex.TryLock());
+    ASSERT_FALSE(mutex.TryLock());
+    ASSERT_FALSE(mutex.TryLockShared());
+    mutex.Unlock();
+
+    ASSERT_TRUE(mutex.TryLockShared());
+    ASSERT_TRUE(mutex.TryLockShared());
+    ASSERT_FALSE(mutex.TryLock());
+    mutex.UnlockShared();
+    mutex.UnlockShared();
+
+    ASSERT_TRUE(mutex.TryLock());
+    mutex.Unlock();
+  }
+
+  SIMPLE_T_TEST(ConcurrentReaders) {
+    CheckConcurrentReaders<solutions::SharedMutex>();
+  }
+
+  SIMPLE_T_TEST(WriterExcludesReaders) {
+    CheckWriterExcludesReaders<solutions::SharedMutex>();
+  }
+
+  SIMPLE_T_TEST(ReadersExcludeWriter) {
+    CheckReadersExcludeWriter<solutions::SharedMutex>();
+  }
+
+  SIMPLE_T_TEST(WriterPreference) {
+    solutions::SharedMutex mutex;
+    twist::stdlike::atomic<bool> written{false};
+
+    mutex.LockShared();
+
+    twist::strand::thread writer([&]() {
+      mutex.Lock();
+      written.store(true);
+      mutex.Unlock();
+    });
+
+    // Let writer announce itself
+    twist::strand::this_thread::sleep_for(100ms);
+
+    // New readers wait for waiting writer
+    ASSERT_FALSE(mutex.TryLockShared());
+
+    twist::strand::thread reader([&]() {
+      mutex.LockShared();
+      ASSERT_TRUE(written.load());
+      mutex.UnlockShared();
+    });
+
+    twist::strand::this_thread::sleep_for(100ms);
+    mutex.UnlockShared();
+
+    writer.join();
+    reader.join();
+  }
+
+#if !defined(TWIST_FIBER)
+
+  SIMPLE_T_TEST(NoContentionNoFutexes) {
+    static const size_t kNoContentionIterations = 1000;
+
+    size_t futex_calls = twist::thread::FutexCallCount();
+
+    solutions::SharedMutex mutex;
+    for (size_t i = 0; i < kNoContentionIterations; ++i) {
+      mutex.LockShared();
+      mutex.LockShared();
+      mutex.UnlockShared();
+      mutex.UnlockShared();
+      mutex.Lock();
+      mutex.Unlock();
+    }
+
+    ASSERT_EQ(futex_calls, twist::thread::FutexCallCount());
+  }
+
+#endif
+}
+
+TEST_SUITE(DistributedSharedMutex) {
+  SIMPLE_T_TEST(LockUnlock) {
+    CheckLockUnlock<solutions::DistributedSharedMutex>();
+  }
+
+  SIMPLE_T_TEST(ConcurrentReaders) {
+    CheckConcurrentReaders<solutions::DistributedSharedMutex>();
+  }
+
+  SIMPLE_T_TEST(WriterExcludesReaders) {
+    CheckWriterExcludesReaders<solutions::DistributedSharedMutex>();
+  }
+
+  SIMPLE_T_TEST(ReadersExcludeWriter) {
+    CheckReadersExcludeWriter<solutions::DistributedSharedMutex>();
+  }
+
+#if !defined(TWIST_FIBER)
+
+  SIMPLE_T_TEST(NoContentionNoFutexes) {
+    static const size_t kNoContentionIterations = 1000;
+
+    size_t futex_calls = twist::thread::FutexCallCount();
+
+    solutions::DistributedSharedMutex mutex;
+    for (size_t i = 0; i < kNoContentionIterations; ++i) {
+      mutex.LockShared();
+      mutex.UnlockShared();
+      mutex.Lock();
+      mutex.Unlock();
+    }
+
+    ASSERT_EQ(futex_calls, twist::thread::FutexCallCount());
+  }
+
+#endif
+}
+
+TEST_SUITE(BRLock) {
+  SIMPLE_T_TEST(LockUnlock) {
+    CheckLockUnlock<solutions::BRLock>();
+  }
+
+  SIMPLE_T_TEST(ConcurrentReaders) {
+    CheckConcurrentReaders<solutions::BRLock>();
+  }
+
+  SIMPLE_T_TEST(WriterExcludesReaders) {
+    CheckWriterExcludesReaders<solutions::BRLock>();
+  }
+
+  SIMPLE_T_TEST(ReadersExcludeWriter) {
+    CheckReadersExcludeWriter<solutions::BRLock>();
+  }
+
+  SIMPLE_T_TEST(SlotAlignment) {
+    // Readers from different threads don't share cache lines
+    ASSERT_TRUE(sizeof(solutions::BRLock) >= 64 * 64);
+  }
+
+#if !defined(TWIST_FIBER)
+
+  SIMPLE_T_TEST(NoContentionNoFutexes) {
+    static const size_t kNoContentionIterations = 1000;
+
+    size_t futex_calls = twist::thread::FutexCallCount();
+
+    solutions::BRLock lock;
+    for (size_t i = 0; i < kNoContentionIterations; ++i) {
+      lock.LockShared();
+      lock.UnlockShared();
+      lock.Lock();
+      lock.Unlock();
+    }
+
+    ASSERT_EQ(futex_calls, twist::thread::FutexCallCount());
+  }
+
+#endif
+}
+
+TEST_SUITE(ReadMostly) {
+  SIMPLE_T_TEST(ReadWrite) {
+    solutions::ReadMostly<std::vector<int>> vector;
+
+    ASSERT_TRUE(vector.Read()->empty());
+
+    vector.Write()->push_back(42);
+    ASSERT_EQ(vector.Read()->front(), 42);
+
+    {
+      auto guard = vector.Write();
+      guard->push_back(7);
+      guard->push_back(99);
+    }
+    ASSERT_EQ(vector.Read()->size(), 3);
+    ASSERT_EQ((*vector.Read())[2], 99);
+  }
+
+  SIMPLE_T_TEST(ConstructorArgs) {
+    solutions::ReadMostly<std::string> string(3, 'x');
+    ASSERT_EQ(*string.Read(), "xxx");
+  }
+
+  SIMPLE_T_TEST(ConcurrentReadsAndWrites) {
+    static const size_t kIterations = 1000;
+
+    solutions::ReadMostly<std::vector<int>> vector;
+
+    twist::strand::thread writer([&]() {
+      for (size_t i = 0; i < kIterations; ++i) {
+        auto guard = vector.Write();
+        guard->push_back(1);
+        guard->push_back(1);
+      }
+    });
+
+    twist::strand::thread reader([&]() {
+      for (size_t i = 0; i < kIterations; ++i) {
+        // Writer pushes values in pairs
+        ASSERT_EQ(vector.Read()->size() % 2, 0);
+      }
+    });
+
+    writer.join();
+    reader.join();
+
+    ASSERT_EQ(vector.Read()->size(), 2 * kIterations);
+  }
+}
+
+RUN_ALL_TESTS()
@@ -4,9 +4,19 @@
 
 // x86-64 only!
 
+// Atomically loads and returns the content of memory location 'addr'
+extern "C" std::int64_t AtomicLoad(volatile std::int64_t* addr);
+
 // Atomically stores 'value' to memory location 'addr'
 extern "C" void AtomicStore(volatile std::int64_t* addr, std::int64_t value);
 
 // Atomically replaces content of memory location `addr` with `value`,
 // returns content of the location before the call
 extern "C" int AtomicExchange(volatile std::int64_t* addr, std::int64_t value);
+
+// Spin-wait loop hint (PAUSE instruction): saves power, frees resources
+// for the sibling hyper-thread and avoids memory order mis-speculation
+// on exit from the loop
+inline void SpinLockPause() {
+  asm volatile("pause" ::: "memory");
+}
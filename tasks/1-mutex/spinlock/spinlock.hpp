@@ -5,23 +5,76 @@
 #include <twist/strand/stdlike.hpp>
 #include <twist/strand/spin_wait.hpp>
 
+#include <cstddef>
+
 using twist::strand::SpinWait;
 
 namespace solutions {
 
-// Simple Test-and-Set (TAS) spinlock
+//////////////////////////////////////////////////////////////////////
+
+// Backoff policies for SpinLock
+// Invoked after each failed attempt to acquire the lock
+
+// Delegates to twist SpinWait
+class SpinWaitBackoff {
+ public:
+  void operator()() {
+    spin_wait_();
+  }
+
+ private:
+  SpinWait spin_wait_;
+};
+
+// Bounded exponential backoff with PAUSE hint:
+// 1, 2, 4, ..., kMaxPauses pauses between attempts,
+// then falls back to SpinWait (which eventually yields)
+class ExponentialBackoff {
+  static const size_t kMaxPauses = 1024;
+
+ public:
+  void operator()() {
+    if (pauses_ > kMaxPauses) {
+      spin_wait_();
+      return;
+    }
+    for (size_t i = 0; i < pauses_; ++i) {
+      SpinLockPause();
+    }
+    pauses_ *= 2;
+  }
+
+ private:
+  size_t pauses_ = 1;
+  SpinWait spin_wait_;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Test-and-Test-and-Set (TTAS) spinlock
+
+// Waiters spin on a plain load (cache line stays shared in their caches)
+// and try AtomicExchange (locked write, exclusive cache line)
+// only when the lock looks free
 
+template <typename Backoff = ExponentialBackoff>
 class SpinLock {
  public:
   void Lock() {
-    SpinWait spin_wait;
-    while (AtomicExchange(&locked_, 1)) {
-      spin_wait();
+    Backoff backoff;
+    while (true) {
+      if (!AtomicExchange(&locked_, 1)) {
+        return;
+      }
+      do {
+        backoff();
+      } while (AtomicLoad(&locked_));
     }
   }
 
   bool TryLock() {
-    return !AtomicExchange(&locked_, 1);  // Not implemented
+    return !AtomicLoad(&locked_) && !AtomicExchange(&locked_, 1);
   }
 
   void Unlock() {
@@ -20,6 +20,7 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 namespace stress {
+  template <typename SpinLock>
   class Tester {
    public:
     Tester(const TTestParameters& parameters)
@@ -78,13 +79,19 @@ namespace stress {
     twist::test_utils::OnePassBarrier start_barrier_;
 
     std::atomic<bool> in_critical_section_{false};
-    solutions::SpinLock spinlock_;
+    SpinLock spinlock_;
   };
 
 };
 
 void StressTest(TTestParameters parameters) {
-  stress::Tester(parameters).Run();
+  stress::Tester<solutions::SpinLock<solutions::ExponentialBackoff>>(parameters)
+      .Run();
+}
+
+void SpinWaitBackoffStressTest(TTestParameters parameters) {
+  stress::Tester<solutions::SpinLock<solutions::SpinWaitBackoff>>(parameters)
+      .Run();
 }
 
 // Parameters: TryLock threads, Lock threads, iterations
@@ -94,6 +101,11 @@ T_TEST_CASES(StressTest)
   .Case({2, 2, 10000})
   .Case({10, 10, 50000});
 
+T_TEST_CASES(SpinWaitBackoffStressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({2, 2, 10000})
+  .Case({10, 10, 50000});
+
 ////////////////////////////////////////////////////////////////////////////////
 
 RUN_ALL_TESTS()
@@ -29,6 +29,22 @@ TEST_SUITE(SpinLock) {
     ASSERT_FALSE(spinlock.TryLock());
   }
 
+  SIMPLE_T_TEST(SpinWaitBackoff) {
+    solutions::SpinLock<solutions::SpinWaitBackoff> spinlock;
+    spinlock.Lock();
+    ASSERT_FALSE(spinlock.TryLock());
+    spinlock.Unlock();
+    ASSERT_TRUE(spinlock.TryLock());
+    spinlock.Unlock();
+  }
+
+  SIMPLE_T_TEST(Load) {
+    std::int64_t var = 42;
+    ASSERT_EQ(AtomicLoad(&var), 42);
+    AtomicStore(&var, 7);
+    ASSERT_EQ(AtomicLoad(&var), 7);
+  }
+
   SIMPLE_T_TEST(Exchange) {
     std::int64_t var = 0;
     for (std::int64_t i = 0; i < 10; ++i) {
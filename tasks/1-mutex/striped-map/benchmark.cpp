@@ -0,0 +1,77 @@
+#include <benchmark/benchmark.h>
+
+#include "striped_map.hpp"
+
+#include "mutex.hpp"
+#include "spinlock.hpp"
+#include "ticket_lock.hpp"
+
+#include <atomic>
+#include <cstdint>
+#include <random>
+
+// YCSB-like workloads over preloaded map
+// Arguments: percentage of reads (A: 50, B: 95, C: 100), stripes
+
+// Remaining operations are updates (read-modify-write)
+// 80% of operations hit 20% of keys
+
+static const uint64_t kKeys = 1 << 16;
+static const uint64_t kHotKeys = kKeys / 5;
+
+static uint64_t NextThreadSeed() {
+  static std::atomic<uint64_t> next{0};
+  return next.fetch_add(1);
+}
+
+template <typename Lock>
+static void BM_Workload(benchmark::State& state) {
+  using Map = solutions::StripedHashMap<uint64_t, uint64_t, Lock>;
+
+  const uint64_t read_ratio = state.range(0);
+
+  // Shared by all benchmark threads
+  static Map* map = nullptr;
+
+  if (state.thread_index() == 0) {
+    map = new Map(state.range(1));
+    for (uint64_t key = 0; key < kKeys; ++key) {
+      map->Insert(key, key);
+    }
+  }
+
+  std::mt19937_64 twister(NextThreadSeed());
+
+  for (auto _ : state) {
+    uint64_t key = (twister() % 5 != 0) ? twister() % kHotKeys
+                                        : twister() % kKeys;
+    if (twister() % 100 < read_ratio) {
+      benchmark::DoNotOptimize(map->Find(key));
+    } else {
+      map->Update(key, [](uint64_t& value) {
+        ++value;
+      });
+    }
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    delete map;
+  }
+}
+
+#define WORKLOAD_BENCHMARK(Lock)        \
+  BENCHMARK_TEMPLATE(BM_Workload, Lock) \
+      ->Args({50, 1})                   \
+      ->Args({50, 64})                  \
+      ->Args({95, 1})                   \
+      ->Args({95, 64})                  \
+      ->Args({100, 64})                 \
+      ->ThreadRange(1, 32)              \
+      ->UseRealTime()
+
+WORKLOAD_BENCHMARK(solutions::SpinLock<>);
+WORKLOAD_BENCHMARK(solutions::TicketLock);
+WORKLOAD_BENCHMARK(solutions::Mutex);
+
+BENCHMARK_MAIN();
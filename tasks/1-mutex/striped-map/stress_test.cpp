@@ -0,0 +1,118 @@
+#include "striped_map.hpp"
+
+#include "mutex.hpp"
+#include "ticket_lock.hpp"
+
+#include <twist/support/random.hpp>
+
+#include <twist/fault/adversary/adversary.hpp>
+#include <twist/fault/adversary/inject_fault.hpp>
+
+#include <twist/test_framework/test_framework.hpp>
+#include <twist/strand/test.hpp>
+
+#include <twist/test_utils/barrier.hpp>
+#include <twist/test_utils/executor.hpp>
+
+#include <chrono>
+#include <vector>
+
+////////////////////////////////////////////////////////////////////////////////
+
+namespace stress {
+  // Each thread owns its key range: thread can predict contents
+  // of its part of the map, while stripes are shared between threads
+
+  template <typename Lock>
+  class Tester {
+   public:
+    Tester(const TTestParameters& parameters)
+        : parameters_(parameters),
+          map_(parameters.Get(1)),
+          start_barrier_(parameters.Get(0)) {
+    }
+
+    // One-shot
+    void Run() {
+      size_t threads = parameters_.Get(0);
+      {
+        twist::test_utils::ScopedExecutor executor;
+        for (size_t t = 0; t < threads; ++t) {
+          executor.Submit(&Tester::RunTestThread, this, t);
+        }
+      }
+      ASSERT_EQ(map_.Size(), 0);
+    }
+
+   private:
+    void RunTestThread(size_t thread_index) {
+      start_barrier_.PassThrough();
+
+      static const size_t kKeys = 64;
+
+      size_t threads = parameters_.Get(0);
+      size_t iterations = parameters_.Get(2);
+
+      std::vector<bool> present(kKeys, false);
+
+      for (size_t i = 0; i < iterations; ++i) {
+        size_t index = twist::RandomUInteger(kKeys - 1);
+        size_t key = index * threads + thread_index;
+
+        if (twist::TossFairCoin()) {
+          ASSERT_EQ(map_.Insert(key, i), !present[index]);
+          present[index] = true;
+        } else {
+          ASSERT_EQ(map_.Erase(key), present[index]);
+          present[index] = false;
+        }
+        twist::fault::InjectFault();
+        ASSERT_EQ(map_.Contains(key), present[index]);
+      }
+
+      // Cleanup
+      for (size_t index = 0; index < kKeys; ++index) {
+        ASSERT_EQ(map_.Erase(index * threads + thread_index), present[index]);
+      }
+    }
+
+   private:
+    TTestParameters parameters_;
+    solutions::StripedHashMap<size_t, size_t, Lock> map_;
+    twist::test_utils::OnePassBarrier start_barrier_;
+  };
+
+}  // namespace stress
+
+void StressTest(TTestParameters parameters) {
+  stress::Tester<solutions::Mutex>(parameters).Run();
+}
+
+void TicketLockStressTest(TTestParameters parameters) {
+  stress::Tester<solutions::TicketLock>(parameters).Run();
+}
+
+// Parameters: threads, stripes, iterations
+
+T_TEST_CASES(StressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({2, 1, 100000})
+  .Case({4, 4, 100000})
+  .Case({8, 16, 50000});
+
+T_TEST_CASES(TicketLockStressTest)
+  .TimeLimit(std::chrono::minutes(1))
+  .Case({2, 1, 100000})
+  .Case({4, 4, 50000});
+
+#if defined(TWIST_FIBER)
+
+T_TEST_CASES(StressTest)
+  .TimeLimit(std::chrono::seconds(30))
+  .Case({10, 4, 100000});
+
+#endif
+
+////////////////////////////////////////////////////////////////////////////////
+
+RUN_ALL_TESTS()
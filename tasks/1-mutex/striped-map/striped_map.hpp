@@ -0,0 +1,346 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+namespace solutions {
+
+// Concurrent hash map with lock striping
+
+// Keys are split between stripes, each stripe is an independent
+// open addressing (linear probing) hash table guarded by its own lock.
+// Stripes are padded to cache line, so operations on different
+// stripes don't interfere.
+//
+// Stripe grows incrementally: new table is allocated, then every
+// subsequent operation on the stripe moves a few entries from the old
+// table. No operation ever rehashes the whole map (or even the whole
+// stripe) at once.
+//
+// Lock: any lock with Lock / Unlock methods
+// (SpinLock, TicketLock, Mutex from this homework)
+
+template <typename K, typename V, typename Lock, typename Hash = std::hash<K>>
+class StripedHashMap {
+  static const size_t kMinCapacity = 8;
+  // Entries moved from old table per operation
+  static const size_t kMigrationBatch = 8;
+
+  struct Entry {
+    std::optional<std::pair<K, V>> item;
+    bool tombstone = false;
+
+    bool IsFree() const {
+      return !item && !tombstone;
+    }
+  };
+
+  class Table {
+   public:
+    Table() = default;
+
+    explicit Table(size_t capacity) : entries_(capacity) {
+    }
+
+    size_t Capacity() const {
+      return entries_.size();
+    }
+
+    size_t Size() const {
+      return size_;
+    }
+
+    bool IsEmpty() const {
+      return entries_.empty();
+    }
+
+    // Load factor (including tombstones) stays below 3/4
+    bool IsFull() const {
+      return (used_ + 1) * 4 > Capacity() * 3;
+    }
+
+    V* Find(const K& key, size_t hash) {
+      if (IsEmpty()) {
+        return nullptr;
+      }
+      size_t mask = Capacity() - 1;
+      for (size_t i = Home(hash) & mask;; i = (i + 1) & mask) {
+        Entry& entry = entries_[i];
+        if (entry.IsFree()) {
+          return nullptr;
+        }
+        if (entry.item && entry.item->first == key) {
+          return &entry.item->second;
+        }
+      }
+    }
+
+    // Key is not present, table is not full
+    void Insert(K key, V value, size_t hash) {
+      size_t mask = Capacity() - 1;
+      for (size_t i = Home(hash) & mask;; i = (i + 1) & mask) {
+        Entry& entry = entries_[i];
+        if (!entry.item) {
+          if (entry.IsFree()) {
+            ++used_;
+          }
+          entry.item.emplace(std::move(key), std::move(value));
+          entry.tombstone = false;
+          ++size_;
+          return;
+        }
+      }
+    }
+
+    bool Erase(const K& key, size_t hash) {
+      if (IsEmpty()) {
+        return false;
+      }
+      size_t mask = Capacity() - 1;
+      for (size_t i = Home(hash) & mask;; i = (i + 1) & mask) {
+        Entry& entry = entries_[i];
+        if (entry.IsFree()) {
+          return false;
+        }
+        if (entry.item && entry.item->first == key) {
+          EraseAt(entry);
+          return true;
+        }
+      }
+    }
+
+    // Removes entry at index (if any) and returns its item
+    std::optional<std::pair<K, V>> Extract(size_t index) {
+      Entry& entry = entries_[index];
+      if (!entry.item) {
+        return std::nullopt;
+      }
+      std::optional<std::pair<K, V>> item = std::move(entry.item);
+      EraseAt(entry);
+      return item;
+    }
+
+   private:
+    // High bits of hash select stripe
+    static size_t Home(size_t hash) {
+      return hash ^ (hash >> 32);
+    }
+
+    void EraseAt(Entry& entry) {
+      // Keep probe chains intact
+      entry.item.reset();
+      entry.tombstone = true;
+      --size_;
+    }
+
+   private:
+    std::vector<Entry> entries_;
+    size_t size_ = 0;
+    size_t used_ = 0;  // Items + tombstones
+  };
+
+  struct alignas(64) Stripe {
+    Lock lock;
+    Table table;
+    // Table being migrated to 'table'
+    Table old_table;
+    size_t migrated = 0;
+  };
+
+  class StripeGuard {
+   public:
+    explicit StripeGuard(Stripe& stripe) : stripe_(stripe) {
+      stripe_.lock.Lock();
+    }
+
+    StripeGuard(const StripeGuard&) = delete;
+    StripeGuard& operator=(const StripeGuard&) = delete;
+
+    ~StripeGuard() {
+      stripe_.lock.Unlock();
+    }
+
+   private:
+    Stripe& stripe_;
+  };
+
+ public:
+  explicit StripedHashMap(size_t stripes = 16)
+      : stripes_(std::make_unique<Stripe[]>(stripes)), stripe_count_(stripes) {
+  }
+
+  // Returns false if key is already present
+  bool Insert(K key, V value) {
+    size_t hash = HashOf(key);
+    Stripe& stripe = StripeOf(hash);
+    StripeGuard guard(stripe);
+
+    MigrateSome(stripe);
+    if (FindIn(stripe, key, hash) != nullptr) {
+      return false;
+    }
+    InsertNew(stripe, std::move(key), std::move(value), hash);
+    return true;
+  }
+
+  // Returns true if key was inserted, false if assigned
+  bool InsertOrAssign(K key, V value) {
+    size_t hash = HashOf(key);
+    Stripe& stripe = StripeOf(hash);
+    StripeGuard guard(stripe);
+
+    MigrateSome(stripe);
+    if (V* current = FindIn(stripe, key, hash)) {
+      *current = std::move(value);
+      return false;
+    }
+    InsertNew(stripe, std::move(key), std::move(value), hash);
+    return true;
+  }
+
+  // Read-modify-write under stripe lock
+  // Returns false if key is not present
+  template <typename F>
+  bool Update(const K& key, F&& update) {
+    size_t hash = HashOf(key);
+    Stripe& stripe = StripeOf(hash);
+    StripeGuard guard(stripe);
+
+    MigrateSome(stripe);
+    if (V* current = FindIn(stripe, key, hash)) {
+      update(*current);
+      return true;
+    }
+    return false;
+  }
+
+  std::optional<V> Find(const K& key) {
+    size_t hash = HashOf(key);
+    Stripe& stripe = StripeOf(hash);
+    StripeGuard guard(stripe);
+
+    MigrateSome(stripe);
+    if (V* value = FindIn(stripe, key, hash)) {
+      return *value;
+    }
+    return std::nullopt;
+  }
+
+  bool Contains(const K& key) {
+    return Find(key).has_value();
+  }
+
+  // Returns false if key is not present
+  bool Erase(const K& key) {
+    size_t hash = HashOf(key);
+    Stripe& stripe = StripeOf(hash);
+    StripeGuard guard(stripe);
+
+    MigrateSome(stripe);
+    return stripe.table.Erase(key, hash) ||
+           stripe.old_table.Erase(key, hash);
+  }
+
+  // Not linearizable: locks stripes one at a time
+  size_t Size() {
+    size_t size = 0;
+    for (size_t i = 0; i < stripe_count_; ++i) {
+      Stripe& stripe = stripes_[i];
+      StripeGuard guard(stripe);
+      size += stripe.table.Size() + stripe.old_table.Size();
+    }
+    return size;
+  }
+
+  size_t StripeCount() const {
+    return stripe_count_;
+  }
+
+ private:
+  size_t HashOf(const K& key) const {
+    // Fibonacci hashing: spread bits of weak hashes (std::hash<int>)
+    return static_cast<size_t>(static_cast<uint64_t>(hasher_(key)) *
+                               0x9E3779B97F4A7C15ull);
+  }
+
+  // High bits select stripe, low bits select slot in stripe table
+  Stripe& StripeOf(size_t hash) {
+    return stripes_[(hash >> 32) % stripe_count_];
+  }
+
+  static V* FindIn(Stripe& stripe, const K& key, size_t hash) {
+    if (V* value = stripe.table.Find(key, hash)) {
+      return value;
+    }
+    return stripe.old_table.Find(key, hash);
+  }
+
+  void InsertNew(Stripe& stripe, K key, V value, size_t hash) {
+    if (stripe.table.IsFull()) {
+      Grow(stripe);
+    }
+    stripe.table.Insert(std::move(key), std::move(value), hash);
+  }
+
+  void Grow(Stripe& stripe) {
+    size_t live = stripe.table.Size() + stripe.old_table.Size() + 1;
+    size_t capacity = kMinCapacity;
+    while (capacity < live * 2) {
+      capacity *= 2;
+    }
+
+    Table table(capacity);
+    // Rare: previous migration lags behind, finish it right away
+    MoveRange(stripe.old_table, stripe.migrated,
+              stripe.old_table.Capacity(), table);
+
+    stripe.old_table = std::exchange(stripe.table, std::move(table));
+    stripe.migrated = 0;
+  }
+
+  void MigrateSome(Stripe& stripe) {
+    Table& old_table = stripe.old_table;
+    if (old_table.IsEmpty()) {
+      return;
+    }
+
+    size_t end = std::min(stripe.migrated + kMigrationBatch,
+                          old_table.Capacity());
+    // Full table: next insert will grow it
+    while (stripe.migrated < end && !stripe.table.IsFull()) {
+      MoveEntry(old_table, stripe.migrated++, stripe.table);
+    }
+
+    if (stripe.migrated == old_table.Capacity()) {
+      // Release memory
+      old_table = Table();
+      stripe.migrated = 0;
+    }
+  }
+
+  void MoveRange(Table& from, size_t begin, size_t end, Table& to) {
+    for (size_t i = begin; i < end; ++i) {
+      MoveEntry(from, i, to);
+    }
+  }
+
+  void MoveEntry(Table& from, size_t index, Table& to) {
+    if (auto item = from.Extract(index)) {
+      size_t hash = HashOf(item->first);
+      to.Insert(std::move(item->first), std::move(item->second), hash);
+    }
+  }
+
+ private:
+  std::unique_ptr<Stripe[]> stripes_;
+  size_t stripe_count_;
+  Hash hasher_;
+};
+
+}  // namespace solutions
@@ -0,0 +1,142 @@
+#include "striped_map.hpp"
+
+#include "mutex.hpp"
+#include "ticket_lock.hpp"
+
+#include <twist/test_framework/test_framework.hpp>
+#include <twist/strand/test.hpp>
+
+#include <twist/test_utils/executor.hpp>
+
+#include <string>
+
+using Map = solutions::StripedHashMap<int, int, solutions::Mutex>;
+
+TEST_SUITE(StripedHashMap) {
+  SIMPLE_T_TEST(InsertFind) {
+    Map map;
+
+    ASSERT_FALSE(map.Find(1));
+    ASSERT_TRUE(map.Insert(1, 10));
+    ASSERT_EQ(*map.Find(1), 10);
+    ASSERT_TRUE(map.Contains(1));
+    ASSERT_FALSE(map.Contains(2));
+    ASSERT_EQ(map.Size(), 1);
+  }
+
+  SIMPLE_T_TEST(InsertExisting) {
+    Map map;
+
+    ASSERT_TRUE(map.Insert(1, 10));
+    ASSERT_FALSE(map.Insert(1, 20));
+    ASSERT_EQ(*map.Find(1), 10);
+
+    ASSERT_FALSE(map.InsertOrAssign(1, 30));
+    ASSERT_EQ(*map.Find(1), 30);
+    ASSERT_TRUE(map.InsertOrAssign(2, 40));
+    ASSERT_EQ(map.Size(), 2);
+  }
+
+  SIMPLE_T_TEST(Update) {
+    Map map;
+
+    ASSERT_FALSE(map.Update(1, [](int& value) {
+      ++value;
+    }));
+
+    map.Insert(1, 10);
+    ASSERT_TRUE(map.Update(1, [](int& value) {
+      ++value;
+    }));
+    ASSERT_EQ(*map.Find(1), 11);
+  }
+
+  SIMPLE_T_TEST(Erase) {
+    Map map;
+
+    ASSERT_FALSE(map.Erase(1));
+    map.Insert(1, 10);
+    map.Insert(2, 20);
+    ASSERT_TRUE(map.Erase(1));
+    ASSERT_FALSE(map.Erase(1));
+    ASSERT_FALSE(map.Contains(1));
+    ASSERT_EQ(*map.Find(2), 20);
+    ASSERT_EQ(map.Size(), 1);
+
+    // Reuse tombstone
+    ASSERT_TRUE(map.Insert(1, 100));
+    ASSERT_EQ(*map.Find(1), 100);
+  }
+
+  SIMPLE_T_TEST(Grow) {
+    // Single stripe: every insert goes through incremental resizing
+    Map map{1};
+
+    static const int kItems = 10000;
+
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_TRUE(map.Insert(i, i * 2));
+      // Items from old table are still visible
+      ASSERT_EQ(*map.Find(i / 2), i / 2 * 2);
+    }
+
+    ASSERT_EQ(map.Size(), kItems);
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_EQ(*map.Find(i), i * 2);
+    }
+  }
+
+  SIMPLE_T_TEST(EraseWhileGrowing) {
+    Map map{1};
+
+    static const int kItems = 10000;
+
+    for (int i = 0; i < kItems; ++i) {
+      map.Insert(i, i);
+      if (i % 2 == 1) {
+        // Erase previous (even) item, maybe still in old table
+        ASSERT_TRUE(map.Erase(i - 1));
+      }
+    }
+
+    ASSERT_EQ(map.Size(), kItems / 2);
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_EQ(map.Contains(i), i % 2 == 1);
+    }
+  }
+
+  SIMPLE_T_TEST(StringKeys) {
+    solutions::StripedHashMap<std::string, std::string, solutions::TicketLock>
+        map{4};
+
+    map.Insert("Hello", "World");
+    map.InsertOrAssign("Foo", "Bar");
+    ASSERT_EQ(*map.Find("Hello"), "World");
+    ASSERT_EQ(*map.Find("Foo"), "Bar");
+    ASSERT_EQ(map.StripeCount(), 4);
+  }
+
+  SIMPLE_T_TEST(ConcurrentInserts) {
+    static const int kThreads = 4;
+    static const int kItems = 10000;
+
+    Map map{8};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (int t = 0; t < kThreads; ++t) {
+      executor.Submit([&map, t]() {
+        for (int i = t; i < kItems; i += kThreads) {
+          ASSERT_TRUE(map.Insert(i, i));
+        }
+      });
+    }
+    executor.Join();
+
+    ASSERT_EQ(map.Size(), kItems);
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_EQ(*map.Find(i), i);
+    }
+  }
+}
+
+RUN_ALL_TESTS()
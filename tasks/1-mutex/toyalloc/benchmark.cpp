@@ -0,0 +1,127 @@
+#include <benchmark/benchmark.h>
+
+#include "toyalloc.hpp"
+
+#include <twist/memory/mmap_allocation.hpp>
+
+#include <mutex>
+#include <vector>
+
+// Allocate / Free throughput: toyalloc vs free list under mutex
+// Arguments: batch size (blocks allocated before release)
+
+static const size_t kArenaPages = 64 * 1024;  // 256MB
+
+// Baseline: same arena, one lock on every operation
+class LockedFreeList {
+  struct Node {
+    Node* next;
+  };
+
+ public:
+  LockedFreeList() : arena_(twist::MmapAllocation::AllocatePages(kArenaPages)) {
+    const size_t block_size = twist::MmapAllocation::PageSize();
+    for (char* addr = arena_.Start(); addr < arena_.End(); addr += block_size) {
+      Free(addr);
+    }
+  }
+
+  void* Allocate() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Node* node = head_;
+    if (node != nullptr) {
+      head_ = node->next;
+    }
+    return node;
+  }
+
+  void Free(void* addr) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Node* node = static_cast<Node*>(addr);
+    node->next = head_;
+    head_ = node;
+  }
+
+ private:
+  twist::MmapAllocation arena_;
+  std::mutex mutex_;
+  Node* head_ = nullptr;
+};
+
+struct ToyAlloc {
+  void* Allocate() {
+    return toyalloc::Allocate();
+  }
+
+  void Free(void* addr) {
+    toyalloc::Free(addr);
+  }
+};
+
+template <typename Allocator>
+static void BM_AllocateFree(benchmark::State& state) {
+  // Shared by all benchmark threads
+  static Allocator allocator;
+
+  const size_t batch_size = state.range(0);
+  std::vector<void*> blocks(batch_size);
+
+  for (auto _ : state) {
+    for (auto& block : blocks) {
+      block = allocator.Allocate();
+      // Touch block
+      benchmark::DoNotOptimize(*static_cast<char*>(block) = 1);
+    }
+    for (void* block : blocks) {
+      allocator.Free(block);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK_TEMPLATE(BM_AllocateFree, LockedFreeList)
+    ->Arg(1)
+    ->Arg(32)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_AllocateFree, ToyAlloc)
+    ->Arg(1)
+    ->Arg(32)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+// Small objects of mixed sizes
+static void BM_SizeClasses(benchmark::State& state) {
+  static const size_t kSizes[] = {16, 24, 40, 64, 100, 200, 512, 1000};
+  static const size_t kSizeCount = sizeof(kSizes) / sizeof(size_t);
+
+  const size_t batch_size = state.range(0);
+  std::vector<void*> blocks(batch_size);
+
+  size_t next = 0;
+  for (auto _ : state) {
+    for (auto& block : blocks) {
+      block = toyalloc::Allocate(kSizes[next++ % kSizeCount]);
+      benchmark::DoNotOptimize(*static_cast<char*>(block) = 1);
+    }
+    for (void* block : blocks) {
+      toyalloc::Free(block);
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * batch_size);
+}
+
+BENCHMARK(BM_SizeClasses)
+    ->Arg(1)
+    ->Arg(32)
+    ->ThreadRange(1, 16)
+    ->UseRealTime();
+
+int main(int argc, char** argv) {
+  toyalloc::Init(twist::MmapAllocation::AllocatePages(kArenaPages));
+
+  benchmark::Initialize(&argc, argv);
+  benchmark::RunSpecifiedBenchmarks();
+  return 0;
+}
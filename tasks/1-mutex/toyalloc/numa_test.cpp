@@ -0,0 +1,134 @@
+#include "toyalloc.hpp"
+
+#include <twist/memory/mmap_allocation.hpp>
+
+#include <twist/test_framework/test_framework.hpp>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <linux/mempolicy.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+// Two logical nodes even on single-node machine
+static const size_t kNodes = 2;
+
+// OS node of (touched) page at 'addr'
+static int NodeIdOfPage(void* addr) {
+  int id = -1;
+  syscall(SYS_get_mempolicy, &id, nullptr, 0, addr,
+          MPOL_F_NODE | MPOL_F_ADDR);
+  return id;
+}
+
+TEST_SUITE(Numa) {
+  SIMPLE_TEST(SplitArena) {
+    ASSERT_EQ(toyalloc::GetNodeCount(), kNodes);
+
+    size_t arena_size = 0;
+    for (size_t node = 0; node < kNodes; ++node) {
+      auto usage = toyalloc::GetNodeUsage(node);
+      ASSERT_EQ(usage.id, (int)node);
+      ASSERT_TRUE(usage.arena_size > 0);
+      arena_size += usage.arena_size;
+    }
+    ASSERT_EQ(arena_size, toyalloc::GetArena().Size());
+  }
+
+  SIMPLE_TEST(LocalAllocations) {
+    std::thread([]() {
+      for (size_t node = 0; node < kNodes; ++node) {
+        toyalloc::SetThreadNode(node);
+        ASSERT_EQ(toyalloc::GetThreadNode(), node);
+
+        void* addr = toyalloc::Allocate(64);
+        ASSERT_TRUE(addr != nullptr);
+        ASSERT_EQ(toyalloc::GetNodeOf(addr), node);
+        ASSERT_TRUE(toyalloc::GetNodeUsage(node).used_size > 0);
+        toyalloc::Free(addr);
+      }
+    }).join();
+  }
+
+  SIMPLE_TEST(Placement) {
+    for (size_t node = 0; node < kNodes; ++node) {
+      auto usage = toyalloc::GetNodeUsage(node);
+      if (!usage.bound) {
+        continue;  // Node is missing on this machine
+      }
+      std::thread([&]() {
+        toyalloc::SetThreadNode(node);
+        char* addr = (char*)toyalloc::Allocate(4096);
+        ASSERT_TRUE(addr != nullptr);
+        memset(addr, 0xFF, 4096);
+        ASSERT_EQ(NodeIdOfPage(addr), usage.id);
+        toyalloc::Free(addr);
+      }).join();
+    }
+  }
+
+  SIMPLE_TEST(RemoteFreeGoesToOwner) {
+    static const size_t kBlocks = 64;
+
+    std::vector<void*> blocks;
+    std::thread([&]() {
+      toyalloc::SetThreadNode(0);
+      for (size_t i = 0; i < kBlocks; ++i) {
+        blocks.push_back(toyalloc::Allocate(256));
+      }
+    }).join();
+
+    std::thread([&]() {
+      toyalloc::SetThreadNode(1);
+      for (void* addr : blocks) {
+        ASSERT_EQ(toyalloc::GetNodeOf(addr), 0u);
+        toyalloc::Free(addr);
+      }
+      // Blocks of node 0 do not stick in node 1 thread cache
+      for (size_t i = 0; i < kBlocks; ++i) {
+        void* addr = toyalloc::Allocate(256);
+        ASSERT_EQ(toyalloc::GetNodeOf(addr), 1u);
+        toyalloc::Free(addr);
+      }
+    }).join();
+  }
+
+  SIMPLE_TEST(FallbackToRemoteNode) {
+    std::thread([]() {
+      toyalloc::SetThreadNode(1);
+
+      std::vector<void*> blocks;
+      while (void* addr = toyalloc::Allocate(toyalloc::GetMaxBlockSize())) {
+        blocks.push_back(addr);
+      }
+
+      // Both nodes exhausted
+      for (size_t node = 0; node < kNodes; ++node) {
+        auto usage = toyalloc::GetNodeUsage(node);
+        ASSERT_EQ(usage.used_size, usage.arena_size);
+      }
+
+      size_t remote = 0;
+      for (void* addr : blocks) {
+        if (toyalloc::GetNodeOf(addr) == 0) {
+          ++remote;
+        }
+        toyalloc::Free(addr);
+      }
+      ASSERT_TRUE(remote > 0);
+    }).join();
+  }
+}
+
+void InitAllocator() {
+  static const size_t kArenaPages = 1024;
+  auto arena = twist::MmapAllocation::AllocatePages(kArenaPages);
+  toyalloc::Init(std::move(arena), kNodes);
+}
+
+int main() {
+  InitAllocator();
+  RunTests(ListAllTests());
+}
@@ -0,0 +1,133 @@
+#include "toyalloc.hpp"
+
+#include <twist/memory/mmap_allocation.hpp>
+
+#include <twist/test_framework/test_framework.hpp>
+
+#include <cstring>
+#include <vector>
+
+#include <sys/mman.h>
+
+// Number of arena pages resident in memory
+static size_t ResidentPages() {
+  auto arena = toyalloc::GetArena();
+  size_t page_size = twist::MmapAllocation::PageSize();
+  std::vector<unsigned char> residency(arena.Size() / page_size);
+  mincore(arena.Begin(), arena.Size(), residency.data());
+
+  size_t resident = 0;
+  for (unsigned char page : residency) {
+    resident += page & 1;
+  }
+  return resident;
+}
+
+TEST_SUITE(SizeClasses) {
+  SIMPLE_TEST(AllocateSizes) {
+    for (size_t size = 1; size <= toyalloc::GetMaxBlockSize(); size = size * 3 / 2 + 1) {
+      char* addr = (char*)toyalloc::Allocate(size);
+      ASSERT_TRUE(addr != nullptr);
+      ASSERT_TRUE(toyalloc::GetBlockSize(addr) >= size);
+      memset(addr, 0xFF, size);
+      toyalloc::Free(addr);
+    }
+  }
+
+  SIMPLE_TEST(MaxBlockSize) {
+    void* addr = toyalloc::Allocate(toyalloc::GetMaxBlockSize());
+    ASSERT_TRUE(addr != nullptr);
+    toyalloc::Free(addr);
+
+    ASSERT_EQ(toyalloc::Allocate(toyalloc::GetMaxBlockSize() + 1), nullptr);
+  }
+
+  SIMPLE_TEST(DefaultBlockSize) {
+    void* addr = toyalloc::Allocate();
+    ASSERT_EQ(toyalloc::GetBlockSize(addr), toyalloc::GetBlockSize());
+    toyalloc::Free(addr);
+  }
+
+  SIMPLE_TEST(InteriorPointer) {
+    char* addr = (char*)toyalloc::Allocate(100);
+    size_t block_size = toyalloc::GetBlockSize(addr);
+    ASSERT_TRUE(block_size >= 100);
+    ASSERT_EQ(toyalloc::GetBlockSize(addr + 99), block_size);
+    toyalloc::Free(addr);
+  }
+
+  SIMPLE_TEST(DistinctBlocks) {
+    static const size_t kBlocks = 10000;
+
+    std::vector<char*> blocks;
+    for (size_t i = 0; i < kBlocks; ++i) {
+      char* addr = (char*)toyalloc::Allocate(24);
+      ASSERT_TRUE(addr != nullptr);
+      memset(addr, (int)(i % 256), 24);
+      blocks.push_back(addr);
+    }
+
+    for (size_t i = 0; i < kBlocks; ++i) {
+      ASSERT_EQ(blocks[i][23], (char)(i % 256));
+      toyalloc::Free(blocks[i]);
+    }
+  }
+
+  SIMPLE_TEST(ReturnEmptySlabs) {
+    static const size_t kBlocks = 64;
+    static const size_t kBlockSize = 16 * 1024;
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < kBlocks; ++i) {
+      void* addr = toyalloc::Allocate(kBlockSize);
+      memset(addr, 1, kBlockSize);
+      blocks.push_back(addr);
+    }
+
+    size_t resident = ResidentPages();
+
+    for (void* addr : blocks) {
+      toyalloc::Free(addr);
+    }
+
+    // Thread cache keeps a few blocks, empty slabs go back to the OS
+    ASSERT_TRUE(ResidentPages() < resident);
+  }
+
+  SIMPLE_TEST(HugePages) {
+    if (!toyalloc::UseHugePages()) {
+      return;  // No THP support
+    }
+
+    static const size_t kBlocks = 64;
+    static const size_t kBlockSize = 16 * 1024;
+
+    std::vector<void*> blocks;
+    for (size_t i = 0; i < kBlocks; ++i) {
+      void* addr = toyalloc::Allocate(kBlockSize);
+      ASSERT_TRUE(addr != nullptr);
+      memset(addr, 1, kBlockSize);
+      blocks.push_back(addr);
+    }
+
+    size_t resident = ResidentPages();
+
+    for (void* addr : blocks) {
+      toyalloc::Free(addr);
+    }
+
+    // Huge pages are not split by slab release
+    ASSERT_TRUE(ResidentPages() >= resident);
+  }
+}
+
+void InitAllocator() {
+  static const size_t kArenaPages = 4096;
+  auto arena = twist::MmapAllocation::AllocatePages(kArenaPages);
+  toyalloc::Init(std::move(arena));
+}
+
+int main() {
+  InitAllocator();
+  RunTests(ListAllTests());
+}
@@ -1,56 +1,942 @@
 #include "toyalloc.hpp"
 
 #include <twist/stdlike/atomic.hpp>
+#include <twist/strand/spin_wait.hpp>
 #include <twist/support/compiler.hpp>
 
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include <linux/mempolicy.h>
 #include <pthread.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 
 using twist::MemSpan;
 using twist::MmapAllocation;
 
 namespace toyalloc {
 
-static const size_t kBlockSize = 4096;
+//////////////////////////////////////////////////////////////////////
+
+// Layout
+
+// Arena is split into slabs of kSlabSize bytes. Free slab belongs to
+// slab heap, used slab is carved into blocks of one size class.
+//
+// Slab headers live outside of the arena (static table indexed by slab
+// number): blocks of 4KB class cover the whole arena, and free slabs
+// can be returned to the OS without losing any metadata
+
+static const size_t kSlabSize = 64 * 1024;
+// Arenas up to 4GB
+static const size_t kMaxSlabs = 1 << 16;
+
+static constexpr size_t kSizeClasses[] = {
+    16,   32,   48,   64,    96,    128,   192,   256,
+    384,  512,  768,  1024,  1536,  2048,  3072,  4096,
+    6144, 8192, 12288, 16384, 24576, 32768, 49152, 65536};
+
+static const size_t kClassCount = sizeof(kSizeClasses) / sizeof(size_t);
+static const uint8_t kNoClass = kClassCount;
+
+static const size_t kMaxBlockSize = kSizeClasses[kClassCount - 1];
+static const size_t kDefaultBlockSize = 4096;
+
+// Size -> size class lookup for sizes up to kLookupLimit
+static const size_t kLookupLimit = 4096;
+
+static constexpr std::array<uint8_t, kLookupLimit / 16 + 1>
+MakeClassLookup() {
+  std::array<uint8_t, kLookupLimit / 16 + 1> lookup{};
+  size_t size_class = 0;
+  for (size_t i = 0; i < lookup.size(); ++i) {
+    while (kSizeClasses[size_class] < i * 16) {
+      ++size_class;
+    }
+    lookup[i] = static_cast<uint8_t>(size_class);
+  }
+  return lookup;
+}
+
+static constexpr auto kClassLookup = MakeClassLookup();
+
+static size_t SizeClassOf(size_t size) {
+  if (size <= kLookupLimit) {
+    return kClassLookup[(size + 15) / 16];
+  }
+  size_t size_class = kClassLookup.back();
+  while (size_class < kClassCount && kSizeClasses[size_class] < size) {
+    ++size_class;
+  }
+  return size_class;
+}
+
+// Blocks cached by thread: ~128KB per size class, 2..16 blocks
+static size_t MagazineSize(size_t size_class) {
+  size_t size = 128 * 1024 / kSizeClasses[size_class];
+  return size < 2 ? 2 : (size > 16 ? 16 : size);
+}
+
+static const size_t kMaxMagazineSize = 16;
+
+//////////////////////////////////////////////////////////////////////
+
+// NUMA
+
+// Raw syscalls: no dependency on libnuma
+
+static const size_t kMaxNodes = 16;
+
+// OS node ids up to 63
+using NodeMask = unsigned long;
+static const size_t kNodeMaskBits = sizeof(NodeMask) * 8;
+
+static NodeMask AllowedNodes() {
+  NodeMask mask = 0;
+  if (syscall(SYS_get_mempolicy, nullptr, &mask, kNodeMaskBits, nullptr,
+              MPOL_F_MEMS_ALLOWED) != 0) {
+    return 1;  // Kernel without NUMA support
+  }
+  return mask;
+}
+
+static int CurrentNodeId() {
+  unsigned cpu;
+  unsigned node;
+  if (syscall(SYS_getcpu, &cpu, &node, nullptr) != 0) {
+    return 0;
+  }
+  return static_cast<int>(node);
+}
+
+// Pages of range are allocated on node 'id' whoever touches them first.
+// Preferred, not strict: falls back to other nodes when node is out of
+// memory instead of OOM kill
+static bool BindToNode(char* begin, size_t size, int id) {
+  NodeMask mask = NodeMask{1} << id;
+  return syscall(SYS_mbind, begin, size, MPOL_PREFERRED, &mask,
+                 kNodeMaskBits + 1, 0) == 0;
+}
+
+//////////////////////////////////////////////////////////////////////
 
 struct BlockNode {
   BlockNode* next_;
 };
 
+struct Slab {
+  // Guarded by central list of size class
+
+  // Blocks given out to thread caches
+  uint32_t live = 0;
+  // Blocks carved from fresh slab memory
+  uint32_t carved = 0;
+  // Released blocks
+  BlockNode* free_blocks = nullptr;
+  // Partial slabs of size class
+  Slab* prev = nullptr;
+  Slab* next = nullptr;
+  bool partial = false;
+
+  // Slab heap link
+  std::atomic<uint32_t> next_free{0};
+};
+
+static Slab slabs[kMaxSlabs];
+// Read-mostly: written only when slab changes hands
+static std::atomic<uint8_t> slab_classes[kMaxSlabs];
+
+//////////////////////////////////////////////////////////////////////
+
+// Test-and-Test-and-Set spinlock with bounded exponential backoff
+
+// Same algorithm as solutions::SpinLock from spinlock task (not
+// reachable from here, and it is built on the raw atomics.S
+// primitives, invisible to twist): spins on a plain load, tries
+// exchange only when the lock looks free, pauses 1, 2, 4, ...,
+// kMaxPauses times between attempts, then falls back to SpinWait
+
+class SpinLock {
+  static const size_t kMaxPauses = 1024;
+
+ public:
+  void Lock() {
+    size_t pauses = 1;
+    twist::strand::SpinWait spin_wait;
+    while (true) {
+      if (!locked_.exchange(true, std::memory_order_acquire)) {
+        return;
+      }
+      do {
+        if (pauses > kMaxPauses) {
+          spin_wait();
+        } else {
+          for (size_t i = 0; i < pauses; ++i) {
+            Pause();
+          }
+          pauses *= 2;
+        }
+      } while (locked_.load(std::memory_order_relaxed));
+    }
+  }
+
+  void Unlock() {
+    locked_.store(false, std::memory_order_release);
+  }
+
+ private:
+  static void Pause() {
+    asm volatile("pause" ::: "memory");
+  }
+
+ private:
+  twist::stdlike::atomic<bool> locked_{false};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Lock-free stack of free slabs (Treiber stack)
+
+// Head is a single 64-bit word: slab number (+1, 0 is empty stack)
+// in low 32 bits and version tag in high 32 bits. Every successful
+// CAS bumps the tag, so a pop that read stale next_free fails even if
+// the same slab is back on top (ABA)
+
+class SlabHeap {
+  using Head = uint64_t;
+
+  static const uint32_t kNil = 0;
+
+ public:
+  // Slabs [first, first + count) of arena
+  void Init(MemSpan arena, size_t first, size_t count) {
+    arena_ = arena;
+    head_.store(Pack(kNil, 0));
+    slab_count_ = count;
+    used_slabs_.store(0);
+
+    // Lower addresses on top
+    for (size_t i = first + count; i > first; --i) {
+      slab_classes[i - 1].store(kNoClass);
+      Push(&slabs[i - 1]);
+    }
+  }
+
+  // Returns nullptr if arena is exhausted
+  Slab* Acquire() {
+    Head head = head_.load();
+    while (true) {
+      uint32_t id = IdOf(head);
+      if (id == kNil) {
+        return nullptr;
+      }
+      uint32_t next = slabs[id - 1].next_free.load(std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Pack(next, TagOf(head) + 1))) {
+        used_slabs_.fetch_add(1, std::memory_order_relaxed);
+        return &slabs[id - 1];
+      }
+    }
+  }
+
+  // Returns slab memory to the OS
+  void Release(Slab* slab) {
+    if (release_pages_.load(std::memory_order_relaxed)) {
+      madvise(Memory(slab), kSlabSize, MADV_DONTNEED);
+    }
+    used_slabs_.fetch_sub(1, std::memory_order_relaxed);
+    Push(slab);
+  }
+
+  // Releasing 64KB of huge page splits it
+  void KeepPages() {
+    release_pages_.store(false);
+  }
+
+  size_t SlabCount() const {
+    return slab_count_;
+  }
+
+  // Slabs given to size classes
+  size_t UsedSlabs() const {
+    return used_slabs_.load(std::memory_order_relaxed);
+  }
+
+  char* Memory(Slab* slab) const {
+    return arena_.Begin() + (slab - slabs) * kSlabSize;
+  }
+
+  Slab* SlabOf(void* addr) const {
+    return &slabs[NumberOf(addr)];
+  }
+
+  size_t NumberOf(void* addr) const {
+    return (static_cast<char*>(addr) - arena_.Begin()) / kSlabSize;
+  }
+
+ private:
+  void Push(Slab* slab) {
+    uint32_t id = static_cast<uint32_t>(slab - slabs) + 1;
+    Head head = head_.load();
+    while (true) {
+      slab->next_free.store(IdOf(head), std::memory_order_relaxed);
+      if (head_.compare_exchange_weak(head, Pack(id, TagOf(head) + 1))) {
+        return;
+      }
+    }
+  }
+
+  static Head Pack(uint32_t id, uint32_t tag) {
+    return (static_cast<Head>(tag) << 32) | id;
+  }
+
+  static uint32_t IdOf(Head head) {
+    return static_cast<uint32_t>(head);
+  }
+
+  static uint32_t TagOf(Head head) {
+    return static_cast<uint32_t>(head >> 32);
+  }
+
+ private:
+  MemSpan arena_;
+  size_t slab_count_ = 0;
+  twist::stdlike::atomic<Head> head_{0};
+  std::atomic<size_t> used_slabs_{0};
+  std::atomic<bool> release_pages_{true};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Blocks of one size class not cached by threads
+
+// Released blocks go back to their slabs (per-slab free lists), so
+// the list knows when slab becomes empty and returns it to slab heap.
+// Guarded by lock, thread caches move blocks in batches
+
+class CentralList {
+  // Empty slabs kept by size class
+  static const size_t kSpareSlabs = 1;
+
+ public:
+  void Init(SlabHeap* heap, size_t size_class) {
+    heap_ = heap;
+    size_class_ = size_class;
+    block_size_ = kSizeClasses[size_class];
+    blocks_per_slab_ = kSlabSize / block_size_;
+  }
+
+  // Moves up to 'count' blocks to 'blocks', returns number of blocks moved
+  size_t Remove(BlockNode** blocks, size_t count) {
+    size_t moved = 0;
+
+    lock_.Lock();
+    while (moved < count) {
+      if (partial_ == nullptr && !AddSlab()) {
+        break;  // Arena exhausted
+      }
+      Slab* slab = partial_;
+      while (moved < count && HasFreeBlocks(slab)) {
+        blocks[moved++] = TakeBlock(slab);
+      }
+      if (!HasFreeBlocks(slab)) {
+        Unlink(slab);
+      }
+    }
+    lock_.Unlock();
+
+    return moved;
+  }
+
+  void Insert(BlockNode** blocks, size_t count) {
+    // Empty slabs, linked through 'next'
+    Slab* empty = nullptr;
+
+    lock_.Lock();
+    for (size_t i = 0; i < count; ++i) {
+      Slab* slab = heap_->SlabOf(blocks[i]);
+
+      blocks[i]->next_ = slab->free_blocks;
+      slab->free_blocks = blocks[i];
+      --slab->live;
+
+      if (slab->live == 0 && empty_slabs_ == kSpareSlabs) {
+        if (slab->partial) {
+          Unlink(slab);
+        }
+        slab->next = empty;
+        empty = slab;
+        continue;
+      }
+
+      if (slab->live == 0) {
+        // Keep spare slab: avoid page faults on alloc / free ping-pong
+        ++empty_slabs_;
+      }
+      if (!slab->partial) {
+        Link(slab);
+      }
+    }
+    lock_.Unlock();
+
+    // madvise outside of the lock
+    while (empty != nullptr) {
+      Slab* slab = empty;
+      empty = slab->next;
+      ResetSlab(slab);
+      heap_->Release(slab);
+    }
+  }
+
+  void Lock() {
+    lock_.Lock();
+  }
+
+  void Unlock() {
+    lock_.Unlock();
+  }
+
+ private:
+  bool AddSlab() {
+    Slab* slab = heap_->Acquire();
+    if (slab == nullptr) {
+      return false;
+    }
+    ++empty_slabs_;
+    slab_classes[slab - slabs].store(static_cast<uint8_t>(size_class_),
+                                     std::memory_order_relaxed);
+    Link(slab);
+    return true;
+  }
+
+  bool HasFreeBlocks(Slab* slab) const {
+    return slab->free_blocks != nullptr || slab->carved < blocks_per_slab_;
+  }
+
+  BlockNode* TakeBlock(Slab* slab) {
+    BlockNode* block;
+    if (slab->free_blocks != nullptr) {
+      block = slab->free_blocks;
+      slab->free_blocks = block->next_;
+    } else {
+      // Fresh memory
+      block = reinterpret_cast<BlockNode*>(heap_->Memory(slab) +
+                                           slab->carved * block_size_);
+      ++slab->carved;
+    }
+    if (slab->live++ == 0) {
+      --empty_slabs_;
+    }
+    return block;
+  }
+
+  static void ResetSlab(Slab* slab) {
+    slab_classes[slab - slabs].store(kNoClass, std::memory_order_relaxed);
+    slab->carved = 0;
+    slab->free_blocks = nullptr;
+  }
+
+  void Link(Slab* slab) {
+    slab->prev = nullptr;
+    slab->next = partial_;
+    if (partial_ != nullptr) {
+      partial_->prev = slab;
+    }
+    partial_ = slab;
+    slab->partial = true;
+  }
+
+  void Unlink(Slab* slab) {
+    if (slab->prev != nullptr) {
+      slab->prev->next = slab->next;
+    } else {
+      partial_ = slab->next;
+    }
+    if (slab->next != nullptr) {
+      slab->next->prev = slab->prev;
+    }
+    slab->prev = slab->next = nullptr;
+    slab->partial = false;
+  }
+
+ private:
+  SpinLock lock_;
+  SlabHeap* heap_ = nullptr;
+  size_t size_class_ = 0;
+  size_t block_size_ = 0;
+  size_t blocks_per_slab_ = 0;
+  Slab* partial_ = nullptr;
+  // Slabs without live blocks kept in partial list
+  size_t empty_slabs_ = 0;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Thread cache: one magazine per size class
+
+// Fast path touches only thread-local memory. Empty magazine is
+// refilled with one batch from central list, full magazine drains
+// one batch.
+//
+// Cache is bound to NUMA node of its thread: magazines hold only
+// blocks of this node. Blocks of other nodes bypass magazines and
+// go straight back to their own central lists
+//
+// Magazine state is also read by fork child handler after the owner
+// thread is gone, so count update is ordered with block handoff:
+// block leaves magazine only after count is decremented and
+// enters it only before count is incremented. Snapshot taken by
+// fork at any point may leak blocks in the child, but never
+// duplicates them
+
+class ThreadCache {
+  friend class CacheRegistry;
+
+  struct Magazine {
+    BlockNode* blocks[kMaxMagazineSize];
+    std::atomic<size_t> count{0};
+  };
+
+ public:
+  ThreadCache();
+  ~ThreadCache();
+
+  void* Allocate(size_t size_class) {
+    Magazine& magazine = magazines_[size_class];
+
+    size_t count = magazine.count.load(std::memory_order_relaxed);
+    if (count == 0) {
+      count = Refill(size_class);
+      if (count == 0) {
+        // Local node exhausted
+        return AllocateRemote(size_class);
+      }
+    }
+    BlockNode* block = magazine.blocks[count - 1];
+    SetCount(magazine, count - 1);
+    return block;
+  }
+
+  void Free(void* addr, size_t size_class, size_t node) {
+    if (node != node_) {
+      FreeRemote(addr, size_class, node);
+      return;
+    }
+
+    Magazine& magazine = magazines_[size_class];
+
+    size_t count = magazine.count.load(std::memory_order_relaxed);
+    if (count == MagazineSize(size_class)) {
+      count = Drain(size_class, count / 2);
+    }
+    magazine.blocks[count] = static_cast<BlockNode*>(addr);
+    SetCount(magazine, count + 1);
+  }
+
+  // Returns all cached blocks to central lists
+  void Flush() {
+    for (size_t size_class = 0; size_class < kClassCount; ++size_class) {
+      Drain(size_class,
+            magazines_[size_class].count.load(std::memory_order_relaxed));
+    }
+  }
+
+  size_t GetNode() const {
+    return node_;
+  }
+
+  void SetNode(size_t node) {
+    Flush();
+    node_ = node;
+  }
+
+ private:
+  static void SetCount(Magazine& magazine, size_t count) {
+    magazine.count.store(count, std::memory_order_release);
+    // Keep compiler from moving block handoff across count update
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+  }
+
+  size_t Refill(size_t size_class);
+  size_t Drain(size_t size_class, size_t size);
+
+  void* AllocateRemote(size_t size_class);
+  void FreeRemote(void* addr, size_t size_class, size_t node);
+
+ private:
+  Magazine magazines_[kClassCount];
+  size_t node_ = 0;
+
+  // Registry links
+  ThreadCache* prev_ = nullptr;
+  ThreadCache* next_ = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// All live thread caches
+
+// Registry lock is held across fork (see pthread_atfork handlers),
+// so child sees consistent list of caches and returns blocks
+// cached by lost threads to central lists
+
+class CacheRegistry {
+ public:
+  void Register(ThreadCache* cache) {
+    lock_.Lock();
+    cache->next_ = head_;
+    if (head_ != nullptr) {
+      head_->prev_ = cache;
+    }
+    head_ = cache;
+    lock_.Unlock();
+  }
+
+  void Unregister(ThreadCache* cache) {
+    lock_.Lock();
+    if (cache->prev_ != nullptr) {
+      cache->prev_->next_ = cache->next_;
+    } else {
+      head_ = cache->next_;
+    }
+    if (cache->next_ != nullptr) {
+      cache->next_->prev_ = cache->prev_;
+    }
+    lock_.Unlock();
+  }
+
+  void Lock() {
+    lock_.Lock();
+  }
+
+  void Unlock() {
+    lock_.Unlock();
+  }
+
+  // Only the forking thread survives, registry is locked
+  void FlushLostCaches(ThreadCache* survivor) {
+    ThreadCache* cache = head_;
+    while (cache != nullptr) {
+      ThreadCache* next = cache->next_;
+      if (cache != survivor) {
+        cache->Flush();
+      }
+      cache = next;
+    }
+
+    head_ = survivor;
+    if (survivor != nullptr) {
+      survivor->prev_ = survivor->next_ = nullptr;
+    }
+  }
+
+ private:
+  SpinLock lock_;
+  ThreadCache* head_ = nullptr;
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Arena is split between NUMA nodes: every node has its own
+// slab heap and central lists
+
+struct Node {
+  int id = 0;  // OS node id
+  bool bound = false;
+  SlabHeap heap;
+  CentralList central[kClassCount];
+};
+
 class Allocator {
  public:
-  void Init(MmapAllocation arena) {
+  // Node ids: OS nodes of logical nodes 0, 1, ...
+  void Init(MmapAllocation arena, const int* node_ids, size_t node_count) {
     arena_ = std::move(arena);
-    // Your code goes here
+    MemSpan span = arena_.AsMemSpan();
+
+    size_t slab_count = span.Size() / kSlabSize;
+    if (slab_count > kMaxSlabs) {
+      slab_count = kMaxSlabs;
+    }
+    if (node_count > slab_count) {
+      node_count = slab_count;
+    }
+    node_count_ = node_count;
+    slabs_per_node_ = slab_count / node_count;
+
+    for (size_t i = 0; i < node_count; ++i) {
+      Node& node = nodes_[i];
+      size_t first = i * slabs_per_node_;
+      // Last node takes the rest
+      size_t count =
+          (i + 1 == node_count) ? slab_count - first : slabs_per_node_;
+
+      node.id = node_ids[i];
+      node.bound = BindToNode(span.Begin() + first * kSlabSize,
+                              count * kSlabSize, node.id);
+      node.heap.Init(span, first, count);
+      for (size_t size_class = 0; size_class < kClassCount; ++size_class) {
+        node.central[size_class].Init(&node.heap, size_class);
+      }
+    }
   }
 
   MemSpan GetArena() const {
     return arena_.AsMemSpan();
   }
 
-  void* Allocate() {
-    // Your code goes here
-    return nullptr;
+  void* Allocate(size_t size);
+  void Free(void* addr);
+
+  size_t GetBlockSize(void* addr) const {
+    return kSizeClasses[SizeClassOf(addr)];
+  }
+
+  CentralList& GetCentralList(size_t node, size_t size_class) {
+    return nodes_[node].central[size_class];
+  }
+
+  CacheRegistry& GetRegistry() {
+    return registry_;
+  }
+
+  // Transparent huge pages for the part of arena aligned to 2MB
+  bool UseHugePages() {
+    static const uintptr_t kHugePageSize = 2 * 1024 * 1024;
+
+    MemSpan span = arena_.AsMemSpan();
+    auto begin = reinterpret_cast<uintptr_t>(span.Begin());
+    auto end = reinterpret_cast<uintptr_t>(span.End());
+    begin = (begin + kHugePageSize - 1) & ~(kHugePageSize - 1);
+    end &= ~(kHugePageSize - 1);
+    if (begin >= end) {
+      return false;  // Arena is too small
+    }
+
+    if (madvise(reinterpret_cast<void*>(begin), end - begin,
+                MADV_HUGEPAGE) != 0) {
+      return false;  // No THP support
+    }
+    for (size_t i = 0; i < node_count_; ++i) {
+      nodes_[i].heap.KeepPages();
+    }
+    return true;
+  }
+
+  // NUMA
+
+  size_t GetNodeCount() const {
+    return node_count_;
+  }
+
+  const Node& GetNode(size_t node) const {
+    return nodes_[node];
+  }
+
+  // Node of memory block
+  size_t NodeOf(void* addr) const {
+    size_t node = SlabNumberOf(addr) / slabs_per_node_;
+    return node < node_count_ ? node : node_count_ - 1;
+  }
+
+  // Node of the calling thread
+  size_t LocalNode() const {
+    int id = CurrentNodeId();
+    for (size_t i = 0; i < node_count_; ++i) {
+      if (nodes_[i].id == id) {
+        return i;
+      }
+    }
+    return 0;
+  }
+
+  // Fork
+
+  void PrepareFork() {
+    registry_.Lock();
+    for (size_t i = 0; i < node_count_; ++i) {
+      for (auto& central : nodes_[i].central) {
+        central.Lock();
+      }
+    }
+  }
+
+  void ParentAfterFork() {
+    UnlockCentralLists();
+    registry_.Unlock();
+  }
+
+  void ChildAfterFork(ThreadCache* survivor) {
+    UnlockCentralLists();
+    registry_.FlushLostCaches(survivor);
+    registry_.Unlock();
+  }
+
+ private:
+  size_t SlabNumberOf(void* addr) const {
+    return (static_cast<char*>(addr) - arena_.AsMemSpan().Begin()) /
+           kSlabSize;
   }
 
-  void Free(void* addr) {
-    // Your code goes here
-    TWIST_UNUSED(addr);
+  size_t SizeClassOf(void* addr) const {
+    return slab_classes[SlabNumberOf(addr)].load(std::memory_order_relaxed);
+  }
+
+  void UnlockCentralLists() {
+    for (size_t i = node_count_; i > 0; --i) {
+      for (size_t size_class = kClassCount; size_class > 0; --size_class) {
+        nodes_[i - 1].central[size_class - 1].Unlock();
+      }
+    }
   }
 
  private:
   MmapAllocation arena_;
-  // Free list goes here
+  Node nodes_[kMaxNodes];
+  size_t node_count_ = 0;
+  size_t slabs_per_node_ = 0;
+  CacheRegistry registry_;
 };
 
 /////////////////////////////////////////////////////////////////////
 
 static Allocator allocator;
 
+// Plain pointer: fork child handler must not construct thread cache
+static thread_local ThreadCache* this_thread_cache = nullptr;
+
+static ThreadCache& GetThreadCache() {
+  static thread_local ThreadCache cache;
+  return cache;
+}
+
 /////////////////////////////////////////////////////////////////////
 
+ThreadCache::ThreadCache() : node_(allocator.LocalNode()) {
+  allocator.GetRegistry().Register(this);
+  this_thread_cache = this;
+}
+
+ThreadCache::~ThreadCache() {
+  this_thread_cache = nullptr;
+  allocator.GetRegistry().Unregister(this);
+  Flush();
+}
+
+size_t ThreadCache::Refill(size_t size_class) {
+  Magazine& magazine = magazines_[size_class];
+  size_t count = allocator.GetCentralList(node_, size_class)
+                     .Remove(magazine.blocks, MagazineSize(size_class) / 2);
+  SetCount(magazine, count);
+  return count;
+}
+
+size_t ThreadCache::Drain(size_t size_class, size_t size) {
+  if (size == 0) {
+    return 0;
+  }
+
+  Magazine& magazine = magazines_[size_class];
+  size_t count = magazine.count.load(std::memory_order_relaxed);
+  size_t rest = count - size;
+
+  // Blocks leave magazine before they become visible in central list
+  SetCount(magazine, rest);
+  allocator.GetCentralList(node_, size_class)
+      .Insert(magazine.blocks + rest, size);
+  return rest;
+}
+
+void* ThreadCache::AllocateRemote(size_t size_class) {
+  size_t node_count = allocator.GetNodeCount();
+  for (size_t i = 1; i < node_count; ++i) {
+    size_t node = (node_ + i) % node_count;
+    BlockNode* block;
+    if (allocator.GetCentralList(node, size_class).Remove(&block, 1) == 1) {
+      return block;
+    }
+  }
+  return nullptr;  // Arena exhausted
+}
+
+void ThreadCache::FreeRemote(void* addr, size_t size_class, size_t node) {
+  // Rare: one block at a time is fine
+  BlockNode* block = static_cast<BlockNode*>(addr);
+  allocator.GetCentralList(node, size_class).Insert(&block, 1);
+}
+
+void* Allocator::Allocate(size_t size) {
+  size_t size_class = toyalloc::SizeClassOf(size);
+  if (size_class == kClassCount) {
+    return nullptr;  // Too large
+  }
+  return GetThreadCache().Allocate(size_class);
+}
+
+void Allocator::Free(void* addr) {
+  GetThreadCache().Free(addr, SizeClassOf(addr), NodeOf(addr));
+}
+
+/////////////////////////////////////////////////////////////////////
+
+// Fork handlers
+
+static void PrepareFork() {
+  allocator.PrepareFork();
+}
+
+static void ParentAfterFork() {
+  allocator.ParentAfterFork();
+}
+
+static void ChildAfterFork() {
+  allocator.ChildAfterFork(this_thread_cache);
+}
+
+/////////////////////////////////////////////////////////////////////
+
+static void InitAllocator(MmapAllocation arena, const int* node_ids,
+                          size_t node_count) {
+  allocator.Init(std::move(arena), node_ids, node_count);
+  // Slab heap is lock-free, but central lists and cache registry are not.
+  // Once per process: handlers registered twice would take
+  // non-recursive locks twice in PrepareFork
+  static std::once_flag atfork_registered;
+  std::call_once(atfork_registered, []() {
+    pthread_atfork(PrepareFork, ParentAfterFork, ChildAfterFork);
+  });
+}
+
 void Init(MmapAllocation arena) {
-  allocator.Init(std::move(arena));
-  // Prepare to fork?
+  int node_ids[kMaxNodes];
+  size_t node_count = 0;
+
+  NodeMask allowed = AllowedNodes();
+  for (size_t id = 0; id < kNodeMaskBits && node_count < kMaxNodes; ++id) {
+    if (allowed & (NodeMask{1} << id)) {
+      node_ids[node_count++] = static_cast<int>(id);
+    }
+  }
+  if (node_count == 0) {
+    node_ids[node_count++] = 0;
+  }
+
+  InitAllocator(std::move(arena), node_ids, node_count);
+}
+
+void Init(MmapAllocation arena, size_t node_count) {
+  int node_ids[kMaxNodes];
+  if (node_count > kMaxNodes) {
+    node_count = kMaxNodes;
+  }
+  for (size_t i = 0; i < node_count; ++i) {
+    node_ids[i] = static_cast<int>(i);
+  }
+
+  InitAllocator(std::move(arena), node_ids, node_count);
 }
 
 MemSpan GetArena() {
@@ -58,15 +944,59 @@ MemSpan GetArena() {
 }
 
 size_t GetBlockSize() {
-  return kBlockSize;
+  return kDefaultBlockSize;
 }
 
 void* Allocate() {
-  return allocator.Allocate();
+  return allocator.Allocate(kDefaultBlockSize);
 }
 
 void Free(void* addr) {
   allocator.Free(addr);
 }
 
+size_t GetMaxBlockSize() {
+  return kMaxBlockSize;
+}
+
+void* Allocate(size_t size) {
+  return allocator.Allocate(size);
+}
+
+size_t GetBlockSize(void* addr) {
+  return allocator.GetBlockSize(addr);
+}
+
+bool UseHugePages() {
+  return allocator.UseHugePages();
+}
+
+// NUMA
+
+size_t GetNodeCount() {
+  return allocator.GetNodeCount();
+}
+
+NodeUsage GetNodeUsage(size_t node) {
+  const Node& info = allocator.GetNode(node);
+  NodeUsage usage;
+  usage.id = info.id;
+  usage.bound = info.bound;
+  usage.arena_size = info.heap.SlabCount() * kSlabSize;
+  usage.used_size = info.heap.UsedSlabs() * kSlabSize;
+  return usage;
+}
+
+size_t GetNodeOf(void* addr) {
+  return allocator.NodeOf(addr);
+}
+
+size_t GetThreadNode() {
+  return GetThreadCache().GetNode();
+}
+
+void SetThreadNode(size_t node) {
+  GetThreadCache().SetNode(node);
+}
+
 }  // namespace toyalloc
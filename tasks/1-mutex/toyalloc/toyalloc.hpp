@@ -4,11 +4,22 @@
 
 namespace toyalloc {
 
+// Splits arena between NUMA nodes allowed for this process
 void Init(twist::MmapAllocation arena);
 
+// Splits arena between 'node_count' nodes with ids 0, 1, ...
+// Nodes missing on this machine keep default memory policy
+void Init(twist::MmapAllocation arena, size_t node_count);
+
+// Backs arena with transparent huge pages (MADV_HUGEPAGE), call after Init
+// Empty slabs are not returned to the OS anymore: that would split
+// huge pages. Returns false if huge pages are not available
+bool UseHugePages();
+
 // Returns arena memory span
 twist::MemSpan GetArena();
 
+// Size of blocks returned by Allocate()
 size_t GetBlockSize();
 
 // Allocates block
@@ -17,4 +28,44 @@ void* Allocate();
 // Releases previously allocated block
 void Free(void* addr);
 
+// Size classes
+
+// Largest size served by Allocate(size)
+size_t GetMaxBlockSize();
+
+// Allocates block of at least 'size' bytes
+// Returns nullptr if 'size' > GetMaxBlockSize() or arena is exhausted
+void* Allocate(size_t size);
+
+// Size of block containing 'addr' (any address inside allocated block)
+size_t GetBlockSize(void* addr);
+
+// NUMA
+
+struct NodeUsage {
+  // OS node id
+  int id;
+  // Memory policy of node arena is set (mbind), otherwise pages
+  // are placed on first touch
+  bool bound;
+  // Bytes of arena owned by node
+  size_t arena_size;
+  // Bytes of node arena in use by size classes (64KB granularity)
+  size_t used_size;
+};
+
+size_t GetNodeCount();
+
+NodeUsage GetNodeUsage(size_t node);
+
+// Node owning block at 'addr'
+size_t GetNodeOf(void* addr);
+
+// Node serving allocations of the calling thread,
+// detected on first allocation
+size_t GetThreadNode();
+
+// Moves allocations of the calling thread to 'node' < GetNodeCount()
+void SetThreadNode(size_t node);
+
 }  // namespace toyalloc
@@ -5,6 +5,16 @@
 #include <twist/test_framework/test_framework.hpp>
 
 #include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <thread>
+
+#include <unistd.h>
+
+#include <sys/types.h>
+#include <sys/wait.h>
+
+void InitAllocator();
 
 TEST_SUITE(ToyAlloc) {
   SIMPLE_TEST(AllocateThenFree) {
@@ -13,6 +23,66 @@ TEST_SUITE(ToyAlloc) {
     toyalloc::Free(addr);
   }
 
+  SIMPLE_TEST(ForkReclaimsThreadCaches) {
+    size_t block_count = toyalloc::GetArena().Size() / toyalloc::GetBlockSize();
+
+    std::atomic<bool> cached{false};
+    std::atomic<bool> done{false};
+
+    // Thread cache of this thread holds blocks during fork
+    std::thread holder([&]() {
+      toyalloc::Free(toyalloc::Allocate());
+      cached.store(true);
+      while (!done.load()) {
+        std::this_thread::yield();
+      }
+    });
+
+    while (!cached.load()) {
+      std::this_thread::yield();
+    }
+
+    pid_t pid = fork();
+
+    if (pid == 0) {
+      // Child: holder thread is lost, its blocks should not be
+      size_t allocated = 0;
+      while (toyalloc::Allocate() != nullptr) {
+        ++allocated;
+      }
+      std::_Exit(allocated == block_count ? 0 : 1);
+    }
+
+    int status;
+    (void)waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+
+    done.store(true);
+    holder.join();
+  }
+
+  SIMPLE_TEST(ForkAfterReinit) {
+    pid_t pid = fork();
+
+    if (pid == 0) {
+      // Fork handlers must not be registered twice:
+      // PrepareFork would take the same locks twice
+      InitAllocator();
+
+      pid_t grandchild = fork();
+      if (grandchild == 0) {
+        std::_Exit(0);
+      }
+      int status;
+      (void)waitpid(grandchild, &status, 0);
+      std::_Exit(WIFEXITED(status) && WEXITSTATUS(status) == 0 ? 0 : 1);
+    }
+
+    int status;
+    (void)waitpid(pid, &status, 0);
+    ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+
   SIMPLE_TEST(AllocateAllArenaTwice) {
     auto arena = toyalloc::GetArena();
     size_t block_size = toyalloc::GetBlockSize();
@@ -1,21 +1,57 @@
 #include <benchmark/benchmark.h>
 
 #include "cyclic_barrier.hpp"
+#include "condvar_barrier.hpp"
+#include "tree_barrier.hpp"
 
-static const size_t kThreads = 16;
-
-solutions::CyclicBarrier barrier{kThreads};
+// Shared by all benchmark threads
+template <typename Barrier>
+static Barrier* barrier = nullptr;
 
+template <typename Barrier>
 static void BM_Runners(benchmark::State& state) {
+  if (state.thread_index() == 0) {
+    barrier<Barrier> = new Barrier(state.threads());
+  }
+
   for (auto _ : state) {
-    barrier.Arrive();
+    barrier<Barrier>->Arrive();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    delete barrier<Barrier>;
   }
 }
 
-BENCHMARK(BM_Runners)
-    ->MinTime(5)
-    ->UseRealTime()
-    ->Threads(kThreads);
+static void BM_TreeRunners(benchmark::State& state) {
+  static solutions::TreeBarrier* tree = nullptr;
 
-BENCHMARK_MAIN();
+  if (state.thread_index() == 0) {
+    tree = new solutions::TreeBarrier(state.threads());
+  }
 
+  const size_t participant = state.thread_index();
+  for (auto _ : state) {
+    tree->Arrive(participant);
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  if (state.thread_index() == 0) {
+    delete tree;
+  }
+}
+
+BENCHMARK_TEMPLATE(BM_Runners, solutions::CondVarBarrier)
+    ->ThreadRange(2, 32)
+    ->UseRealTime();
+
+BENCHMARK_TEMPLATE(BM_Runners, solutions::CyclicBarrier)
+    ->ThreadRange(2, 32)
+    ->UseRealTime();
+
+BENCHMARK(BM_TreeRunners)
+    ->ThreadRange(2, 32)
+    ->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -1,43 +1,139 @@
 #pragma once
 
-#include <twist/stdlike/mutex.hpp>
-#include <twist/stdlike/condition_variable.hpp>
+#include <twist/stdlike/atomic.hpp>
+#include <twist/strand/spin_wait.hpp>
+#include <twist/twisted/futex.hpp>
 
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <utility>
 
 namespace solutions {
 
+namespace detail {
+
+// Phase number of a barrier: participants wait for it to move on.
+// Spins for a while (phases are often short), then blocks on futex.
+// Advance makes a syscall only if someone is blocked
+class alignas(64) BarrierPhase {
+  static const size_t kSpinLimit = 128;
+
+ public:
+  uint32_t Load() const {
+    return phase_.load(std::memory_order_acquire);
+  }
+
+  // Blocks until phase moves past 'phase'
+  void WaitPast(uint32_t phase) {
+    twist::strand::SpinWait spin_wait;
+    for (size_t i = 0; i < kSpinLimit; ++i) {
+      if (Load() != phase) {
+        return;  // Fast path
+      }
+      spin_wait();
+    }
+
+    waiters_.fetch_add(1);
+    // Pairs with waiters_.load() in Advance: either we see new phase
+    // or advancing thread sees us
+    while (phase_.load() == phase) {
+      futex_.Wait(phase);
+    }
+    waiters_.fetch_sub(1);
+  }
+
+  void Advance() {
+    phase_.fetch_add(1);
+    if (waiters_.load() > 0) {
+      futex_.WakeAll();
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> phase_{0};
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+  twist::twisted::Futex futex_{phase_};
+};
+
+}  // namespace detail
+
+// Sense-reversing barrier: one atomic counter of arrived threads
+// and a phase number instead of mutex + condvar.
+// Phase is a "sense" that never repeats, so a fast thread that
+// re-arrives before the others have left cannot confuse them
+//
+// Split phases, as in std::barrier: ArriveNoWait / Wait(token) let
+// a thread do independent work between arriving and waiting.
+// Optional completion runs once per phase on the last arriving thread,
+// before anyone is released
+
 class CyclicBarrier {
  public:
-  explicit CyclicBarrier(size_t participants /*participants*/) {
-    this->num_of_participants_ = participants;
-    num_of_threads_to_arrive_ = participants;
+  using CompletionFunction = std::function<void()>;
+
+  // Phase the thread has arrived at
+  struct ArrivalToken {
+    uint32_t phase;
+  };
+
+  explicit CyclicBarrier(size_t participants,
+                         CompletionFunction on_completion = nullptr)
+      : expected_(static_cast<uint32_t>(participants)),
+        on_completion_(std::move(on_completion)) {
   }
 
+  // Arrives and blocks until the phase completes
   void Arrive() {
-    // Not implemented
-    std::unique_lock<twist::stdlike::mutex> lock(mutex_);
-    int local_num_of_wave = num_of_wave_to_wait_;
-    --num_of_threads_to_arrive_;
-
-    while (num_of_threads_to_arrive_ > 0 &&
-           local_num_of_wave == num_of_wave_to_wait_) {
-      all_threads_arrived_.wait(lock);
+    Wait(ArriveNoWait());
+  }
+
+  // Arrives, never blocks
+  ArrivalToken ArriveNoWait() {
+    // Phase cannot move on before we arrive
+    uint32_t phase = phase_.Load();
+    // Read before arrival: last thread changes expected_ after it
+    uint32_t expected = expected_;
+    if (arrived_.fetch_add(1) + 1 == expected) {
+      CompletePhase();
     }
-    if (num_of_threads_to_arrive_ == 0) {
-      all_threads_arrived_.notify_all();
-      num_of_threads_to_arrive_ = num_of_participants_;
-      num_of_wave_to_wait_++;
+    return {phase};
+  }
+
+  // Blocks until the phase of 'token' completes
+  void Wait(ArrivalToken token) {
+    phase_.WaitPast(token.phase);
+  }
+
+  // Arrives at current phase and leaves the barrier:
+  // next phases expect one participant less
+  void ArriveAndDrop() {
+    dropped_.fetch_add(1);
+    ArriveNoWait();
+  }
+
+ private:
+  // Last one: run completion, reset counters for the next phase,
+  // then release. Threads arrive at the next phase only after they see
+  // the new phase, so they see the reset too
+  void CompletePhase() {
+    if (on_completion_) {
+      on_completion_();
     }
+    expected_ -= dropped_.exchange(0);
+    arrived_.store(0, std::memory_order_relaxed);
+    phase_.Advance();
   }
 
  private:
-  // Your code goes here
-  twist::stdlike::mutex mutex_;
-  twist::stdlike::condition_variable all_threads_arrived_;
-  int num_of_threads_to_arrive_;
-  int num_of_participants_;
-  int num_of_wave_to_wait_ = 0;
+  // Participants of current phase, changed only between phases
+  uint32_t expected_;
+  CompletionFunction on_completion_;
+  // Written by every arriving thread, on its own cache line
+  alignas(64) twist::stdlike::atomic<uint32_t> arrived_{0};
+  twist::stdlike::atomic<uint32_t> dropped_{0};
+  // Read by every waiting thread
+  detail::BarrierPhase phase_;
 };
 
 }  // namespace solutions
@@ -1,4 +1,5 @@
 #include "cyclic_barrier.hpp"
+#include "tree_barrier.hpp"
 
 #include <twist/test_framework/test_framework.hpp>
 #include <twist/strand/test.hpp>
@@ -6,17 +7,27 @@
 #include <twist/test_utils/executor.hpp>
 #include <twist/test_utils/barrier.hpp>
 
+#include <algorithm>
 #include <vector>
 
 ////////////////////////////////////////////////////////////////////////////////
 
-void RotatingLeaderStressTest(const TTestParameters& parameters) {
+static void Arrive(solutions::CyclicBarrier& barrier, size_t /*index*/) {
+  barrier.Arrive();
+}
+
+static void Arrive(solutions::TreeBarrier& barrier, size_t index) {
+  barrier.Arrive(index);
+}
+
+template <typename Barrier, typename... Args>
+void RotatingLeader(const TTestParameters& parameters, Args... args) {
   size_t threads = parameters.Get(0);
-  solutions::CyclicBarrier barrier{threads};
+  Barrier barrier{threads, args...};
   size_t round = 0;
 
   auto routine = [&](size_t thread_index) {
-    barrier.Arrive();
+    Arrive(barrier, thread_index);
 
     size_t iterations = parameters.Get(1);
     for (size_t i = 0; i < iterations; ++i) {
@@ -27,12 +38,12 @@ void RotatingLeaderStressTest(const TTestParameters& parameters) {
         twist::strand::this_thread::yield();
       }
 
-      barrier.Arrive();
+      Arrive(barrier, thread_index);
 
       // All threads read from shared variable
       ASSERT_EQ(round, i);
 
-      barrier.Arrive();
+      Arrive(barrier, thread_index);
     }
   };
 
@@ -42,6 +53,10 @@ void RotatingLeaderStressTest(const TTestParameters& parameters) {
   }
 }
 
+void RotatingLeaderStressTest(const TTestParameters& parameters) {
+  RotatingLeader<solutions::CyclicBarrier>(parameters);
+}
+
 T_TEST_CASES(RotatingLeaderStressTest)
     .TimeLimit(std::chrono::seconds(30))
     .Case({2, 50000})
@@ -58,6 +73,72 @@ T_TEST_CASES(RotatingLeaderStressTest)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void TreeRotatingLeaderStressTest(const TTestParameters& parameters) {
+  RotatingLeader<solutions::TreeBarrier>(parameters, parameters.Get(2));
+}
+
+// Parameters: threads, iterations, fan-in
+T_TEST_CASES(TreeRotatingLeaderStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({2, 50000, 2})
+    .Case({5, 25000, 2})
+    .Case({10, 10000, 3})
+    .Case({16, 5000, 4});
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Threads overlap work with barrier latency and leave one by one
+void SplitPhaseStressTest(const TTestParameters& parameters) {
+  size_t threads = parameters.Get(0);
+  size_t iterations = parameters.Get(1);
+
+  std::vector<size_t> values(threads, 0);
+  size_t sum = 0;
+  size_t completed = 0;
+
+  solutions::CyclicBarrier barrier{threads, [&]() {
+    // All threads have written their values for this phase
+    sum = 0;
+    for (size_t value : values) {
+      sum += value;
+    }
+    ++completed;
+  }};
+
+  auto routine = [&](size_t thread_index) {
+    // Thread 'i' leaves after 'iterations - i' phases
+    size_t phases = iterations - thread_index;
+    for (size_t i = 0; i < phases; ++i) {
+      values[thread_index] += 1;
+      auto token = barrier.ArriveNoWait();
+      twist::strand::this_thread::yield();  // Independent work
+      barrier.Wait(token);
+      // Two phases per iteration
+      ASSERT_EQ(completed, 2 * i + 1);
+      // Threads that have left reset their values
+      size_t active = std::min(threads, iterations - i);
+      ASSERT_EQ(sum, active * (i + 1));
+      barrier.Arrive();
+    }
+    values[thread_index] = 0;
+    barrier.ArriveAndDrop();
+  };
+
+  twist::test_utils::ScopedExecutor executor;
+  for (size_t i = 0; i < threads; ++i) {
+    executor.Submit(routine, i);
+  }
+}
+
+// Parameters: threads, iterations
+T_TEST_CASES(SplitPhaseStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({2, 20000})
+    .Case({5, 10000})
+    .Case({10, 5000});
+
+////////////////////////////////////////////////////////////////////////////////
+
 namespace rotate {
   class Tester {
    public:
@@ -0,0 +1,93 @@
+#pragma once
+
+#include "cyclic_barrier.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace solutions {
+
+// Combining tree barrier for many participants
+
+// Participants are split into groups of 'fan_in' threads, each group
+// arrives at its own leaf node. The last thread to arrive at a node
+// carries arrival up to the parent, the last one at the root advances
+// the phase. So at most 'fan_in' threads contend on any counter,
+// instead of all of them on one.
+//
+// Participant must pass its index in [0, participants) to Arrive.
+// fan_in >= 2: otherwise every level is as wide as the one below
+
+class TreeBarrier {
+  struct alignas(64) Node {
+    twist::stdlike::atomic<uint32_t> arrived{0};
+    uint32_t fan_in = 0;
+    Node* parent = nullptr;
+  };
+
+ public:
+  explicit TreeBarrier(size_t participants, size_t fan_in = 4)
+      : fan_in_(fan_in) {
+    assert(participants >= 1);
+    assert(fan_in >= 2);
+    BuildTree(participants);
+  }
+
+  void Arrive(size_t participant) {
+    uint32_t phase = phase_.Load();
+
+    Node* node = leaves_[participant / fan_in_];
+    while (node != nullptr) {
+      if (node->arrived.fetch_add(1) + 1 < node->fan_in) {
+        phase_.WaitPast(phase);
+        return;
+      }
+      // Last at this node: reset it for the next phase
+      // (released by Advance) and go up
+      node->arrived.store(0, std::memory_order_relaxed);
+      node = node->parent;
+    }
+
+    // Last at root
+    phase_.Advance();
+  }
+
+ private:
+  // Level by level from leaves to root
+  void BuildTree(size_t participants) {
+    std::vector<Node*> level = MakeLevel(participants);
+    leaves_ = level;
+    while (level.size() > 1) {
+      std::vector<Node*> parents = MakeLevel(level.size());
+      for (size_t i = 0; i < level.size(); ++i) {
+        level[i]->parent = parents[i / fan_in_];
+      }
+      level = std::move(parents);
+    }
+  }
+
+  // Nodes for 'count' children, 'fan_in_' children per node
+  std::vector<Node*> MakeLevel(size_t count) {
+    std::vector<Node*> level;
+    for (size_t first = 0; first < count; first += fan_in_) {
+      nodes_.push_back(std::make_unique<Node>());
+      Node* node = nodes_.back().get();
+      node->fan_in = static_cast<uint32_t>(std::min(fan_in_, count - first));
+      level.push_back(node);
+    }
+    return level;
+  }
+
+ private:
+  const size_t fan_in_;
+  std::vector<std::unique_ptr<Node>> nodes_;
+  std::vector<Node*> leaves_;
+  detail::BarrierPhase phase_;
+};
+
+}  // namespace solutions
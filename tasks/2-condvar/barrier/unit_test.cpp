@@ -1,10 +1,15 @@
 #include "cyclic_barrier.hpp"
+#include "tree_barrier.hpp"
 
 #include <twist/test_framework/test_framework.hpp>
 #include <twist/strand/test.hpp>
 
 #include <twist/strand/stdlike.hpp>
 
+#include <atomic>
+#include <chrono>
+#include <vector>
+
 TEST_SUITE(CyclicBarrier) {
   SIMPLE_T_TEST(OneThread) {
     solutions::CyclicBarrier barrier{1};
@@ -67,4 +72,122 @@ TEST_SUITE(CyclicBarrier) {
   }
 }
 
+TEST_SUITE(SplitPhase) {
+  SIMPLE_T_TEST(Completion) {
+    static const size_t kThreads = 5;
+    static const size_t kPhases = 100;
+
+    size_t completed = 0;
+    solutions::CyclicBarrier barrier{kThreads, [&]() {
+      ++completed;
+    }};
+
+    auto routine = [&]() {
+      for (size_t i = 0; i < kPhases; ++i) {
+        barrier.Arrive();
+        // Completion runs before anyone is released
+        ASSERT_TRUE(completed >= i + 1);
+        barrier.Arrive();
+      }
+    };
+
+    std::vector<twist::strand::thread> threads;
+    for (size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back(routine);
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    ASSERT_EQ(completed, 2 * kPhases);
+  }
+
+  SIMPLE_T_TEST(ArriveNoWait) {
+    solutions::CyclicBarrier barrier{2};
+
+    std::atomic<bool> arrived{false};
+
+    twist::strand::thread that([&]() {
+      auto token = barrier.ArriveNoWait();
+      arrived.store(true);  // Independent work
+      barrier.Wait(token);
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+    // Arrived, but not blocked
+    ASSERT_TRUE(arrived.load());
+
+    barrier.Arrive();
+    that.join();
+  }
+
+  SIMPLE_T_TEST(LastArrivalDoesNotBlock) {
+    solutions::CyclicBarrier barrier{1};
+    auto token = barrier.ArriveNoWait();
+    barrier.Wait(token);
+    barrier.Wait(token);  // Completed phase
+  }
+
+  SIMPLE_T_TEST(ArriveAndDrop) {
+    size_t completed = 0;
+    solutions::CyclicBarrier barrier{2, [&]() {
+      ++completed;
+    }};
+
+    twist::strand::thread dropped([&]() {
+      barrier.Arrive();
+      barrier.ArriveAndDrop();
+    });
+
+    barrier.Arrive();
+    barrier.Arrive();
+    dropped.join();
+    ASSERT_EQ(completed, 2u);
+
+    // The only participant left
+    barrier.Arrive();
+    ASSERT_EQ(completed, 3u);
+  }
+}
+
+TEST_SUITE(TreeBarrier) {
+  SIMPLE_T_TEST(OneThread) {
+    solutions::TreeBarrier barrier{1};
+
+    for (size_t i = 0; i < 10; ++i) {
+      barrier.Arrive(0);
+    }
+  }
+
+  SIMPLE_T_TEST(Runners) {
+    // Incomplete groups at every level
+    static const size_t kThreads = 11;
+    solutions::TreeBarrier barrier{kThreads, /*fan_in=*/3};
+
+    static const size_t kIterations = 256;
+    std::atomic<size_t> arrived{0};
+
+    auto runner_routine = [&](size_t index) {
+      for (size_t i = 0; i < kIterations; ++i) {
+        arrived.fetch_add(1);
+        barrier.Arrive(index);
+        // Nobody passes before everyone arrives
+        ASSERT_TRUE(arrived.load() >= (i + 1) * kThreads);
+        barrier.Arrive(index);
+      }
+    };
+
+    std::vector<twist::strand::thread> runners;
+
+    for (size_t i = 0; i < kThreads; ++i) {
+      runners.emplace_back(runner_routine, i);
+    }
+
+    for (auto& runner : runners) {
+      runner.join();
+    }
+  }
+}
+
 RUN_ALL_TESTS()
@@ -0,0 +1,159 @@
+#include <benchmark/benchmark.h>
+
+#include "condvar.hpp"
+
+#include <twist/stdlike/mutex.hpp>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Notify with nobody waiting: the common case for queues
+// that notify on every push
+
+static void BM_NotifyNoWaiters(benchmark::State& state) {
+  solutions::ConditionVariable condvar;
+  for (auto _ : state) {
+    condvar.NotifyOne();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_NotifyNoWaiters);
+
+static void BM_NotifyAllNoWaiters(benchmark::State& state) {
+  solutions::ConditionVariable condvar;
+  for (auto _ : state) {
+    condvar.NotifyAll();
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_NotifyAllNoWaiters);
+
+// Blocking queue that notifies on every push.
+// Arguments: producers, consumers
+
+static const size_t kItems = 1 << 16;
+
+class BlockingQueue {
+ public:
+  void Put(size_t item) {
+    std::unique_lock lock(mutex_);
+    items_.push_back(item);
+    lock.unlock();
+    not_empty_.NotifyOne();
+  }
+
+  size_t Take() {
+    std::unique_lock lock(mutex_);
+    while (items_.empty()) {
+      not_empty_.Wait(lock);
+    }
+    size_t item = items_.front();
+    items_.pop_front();
+    return item;
+  }
+
+ private:
+  twist::stdlike::mutex mutex_;
+  std::deque<size_t> items_;
+  solutions::ConditionVariable not_empty_;
+};
+
+static void BM_Queue(benchmark::State& state) {
+  const size_t producers = state.range(0);
+  const size_t consumers = state.range(1);
+
+  for (auto _ : state) {
+    BlockingQueue queue;
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p]() {
+        for (size_t i = p; i < kItems; i += producers) {
+          queue.Put(i);
+        }
+      });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&, c]() {
+        for (size_t i = c; i < kItems; i += consumers) {
+          benchmark::DoNotOptimize(queue.Take());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_Queue)
+    ->Args({1, 1})
+    ->Args({4, 1})
+    ->Args({1, 4})
+    ->Args({4, 4})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// NotifyAll to many waiters that all need the mutex.
+// Arguments: waiters
+
+static void BM_Broadcast(benchmark::State& state) {
+  const size_t waiters = state.range(0);
+
+  twist::stdlike::mutex mutex;
+  solutions::ConditionVariable condvar;
+  solutions::ConditionVariable all_waiting;
+  size_t round = 0;
+  size_t waiting = 0;
+  bool stop = false;
+
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < waiters; ++i) {
+    threads.emplace_back([&]() {
+      std::unique_lock lock(mutex);
+      size_t seen = round;
+      while (!stop) {
+        if (++waiting == waiters) {
+          all_waiting.NotifyOne();
+        }
+        while (round == seen && !stop) {
+          condvar.Wait(lock);
+        }
+        seen = round;
+      }
+    });
+  }
+
+  for (auto _ : state) {
+    std::unique_lock lock(mutex);
+    while (waiting < waiters) {
+      all_waiting.Wait(lock);
+    }
+    waiting = 0;
+    ++round;
+    condvar.NotifyAll();
+  }
+
+  {
+    std::unique_lock lock(mutex);
+    stop = true;
+    condvar.NotifyAll();
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  state.SetItemsProcessed(state.iterations() * waiters);
+}
+
+BENCHMARK(BM_Broadcast)
+    ->Arg(8)
+    ->Arg(64)
+    ->UseRealTime()
+    ->Unit(benchmark::kMicrosecond);
+
+BENCHMARK_MAIN();
@@ -1,42 +1,235 @@
 #pragma once
 
 #include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+#include <twist/strand/spin_wait.hpp>
 #include <twist/twisted/futex.hpp>
 
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+
 namespace solutions {
 
+// Condition variable with explicit FIFO queue of waiters
+
+// Every waiter sleeps on its own futex word, so notification wakes
+// exactly the threads it chooses.
+//
+// NotifyAll does not wake everyone at once (they would only wake up
+// to fight for the mutex): it wakes the first waiter and chains the rest
+// behind it. Each woken waiter wakes the next one only after it has
+// re-acquired the mutex, so the next one goes straight to sleep
+// on the mutex instead of contending with the whole herd.
+// This is wait morphing (FUTEX_CMP_REQUEUE) done in userspace,
+// and it works with any mutex.
+//
+// Futex wait has no timeout, so timed waiters poll their state and
+// notice notification up to kMaxBackoff late. They never join
+// NotifyAll chain: they are woken at once and the chain goes on
+// without waiting for them.
+//
+// Number of queued waiters is mirrored in an atomic, so notification
+// with nobody waiting is a single load: no lock, no syscall
+
 class ConditionVariable {
- public:
-  ConditionVariable() {
-    // Not implemented
-  }
+  enum State : uint32_t {
+    kWaiting = 0,   // In queue or in NotifyAll chain
+    kNotified = 1,  // Woken
+  };
 
+  struct Node {
+    twist::stdlike::atomic<uint32_t> state{kWaiting};
+    twist::twisted::Futex futex{state};
+    // Polls state instead of sleeping on futex
+    bool timed = false;
+    // Neighbours in queue, successor in NotifyAll chain
+    Node* prev = nullptr;
+    Node* next = nullptr;
+  };
+
+ public:
   template <class Mutex>
   void Wait(Mutex& mutex) {
-    // Not implemented
-    // Use mutex.unlock() / mutex.lock() to unlock/lock mutex
-    uint32_t expected = state_.load();
+    Node node;
+    Enqueue(&node);
+    // Notifier finds us in queue, no lost wakeups
+    mutex.unlock();
+
+    uint32_t state;
+    while ((state = node.state.load()) != kNotified) {
+      node.futex.Wait(state);
+    }
+
+    mutex.lock();
+    PassBaton(&node);
+  }
+
+  // Returns false on timeout.
+  // Polls with growing sleeps, so wakeup may lag behind
+  // notification by up to kMaxBackoff
+  template <class Mutex, class Clock, class Duration>
+  bool WaitUntil(Mutex& mutex,
+                 std::chrono::time_point<Clock, Duration> deadline) {
+    Node node;
+    node.timed = true;
+    Enqueue(&node);
     mutex.unlock();
-    futex_.Wait(expected);
+
+    bool notified = true;
+    std::chrono::microseconds backoff{1};
+
+    while (node.state.load() != kNotified) {
+      auto now = Clock::now();
+      if (now >= deadline) {
+        notified = Cancel(&node);
+        break;
+      }
+      auto remains =
+          std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+      twist::stdlike::this_thread::sleep_for(std::min(backoff, remains));
+      if (backoff < kMaxBackoff) {
+        backoff *= 2;
+      }
+    }
+
     mutex.lock();
+    PassBaton(&node);
+    return notified;
+  }
+
+  template <class Mutex, class Rep, class Period>
+  bool WaitFor(Mutex& mutex, std::chrono::duration<Rep, Period> timeout) {
+    return WaitUntil(mutex, std::chrono::steady_clock::now() + timeout);
   }
 
   void NotifyOne() {
-    state_.fetch_add(1);
-    futex_.WakeOne();
-    // Not implemented
+    if (waiters_.load() == 0) {
+      return;  // Fast path
+    }
+    Lock();
+    if (Node* node = head_) {
+      Unlink(node);
+      Wake(node);
+    }
+    Unlock();
   }
 
   void NotifyAll() {
-    state_.fetch_add(1);
-    futex_.WakeAll();
-    // Not implemented
+    if (waiters_.load() == 0) {
+      return;  // Fast path
+    }
+    Lock();
+    Node* node = head_;
+    head_ = tail_ = nullptr;
+    waiters_.store(0);
+
+    // Detach the whole queue: blocking waiters form a chain,
+    // timed ones would hold it up while polling, so wake them now
+    Node* first = nullptr;
+    Node* last = nullptr;
+    while (node != nullptr) {
+      Node* next = node->next;
+      node->prev = node->next = nullptr;
+      if (node->timed) {
+        Wake(node);
+      } else {
+        if (last != nullptr) {
+          last->next = node;
+        } else {
+          first = node;
+        }
+        last = node;
+      }
+      node = next;
+    }
+    if (first != nullptr) {
+      Wake(first);
+    }
+    Unlock();
+  }
+
+ private:
+  static constexpr std::chrono::microseconds kMaxBackoff{256};
+
+  void Enqueue(Node* node) {
+    Lock();
+    node->prev = tail_;
+    if (tail_ != nullptr) {
+      tail_->next = node;
+    } else {
+      head_ = node;
+    }
+    tail_ = node;
+    // Before mutex.unlock() in Wait: notifier that has changed
+    // the state under the mutex sees us
+    waiters_.fetch_add(1);
+    Unlock();
+  }
+
+  // Woken waiter holds the mutex: wakes the next one in NotifyAll chain.
+  // Also waits for notifier to leave Wake, so that node can be destroyed
+  void PassBaton(Node* node) {
+    Lock();
+    if (Node* next = node->next) {
+      node->next = nullptr;
+      Wake(next);
+    }
+    Unlock();
+  }
+
+  // Timed out: leaves queue (timed waiter is never chained).
+  // Returns true if notification has arrived anyway
+  bool Cancel(Node* node) {
+    Lock();
+    bool notified = node->state.load() == kNotified;
+    if (!notified) {
+      Unlink(node);
+    }
+    Unlock();
+    return notified;
+  }
+
+  // Removes node from queue
+  void Unlink(Node* node) {
+    if (node->prev != nullptr) {
+      node->prev->next = node->next;
+    } else {
+      head_ = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    } else {
+      tail_ = node->prev;
+    }
+    node->prev = node->next = nullptr;
+    waiters_.fetch_sub(1);
+  }
+
+  // Under lock_: waiter cannot destroy node until we are done
+  static void Wake(Node* node) {
+    node->state.store(kNotified);
+    node->futex.WakeOne();
+  }
+
+  void Lock() {
+    twist::strand::SpinWait spin_wait;
+    while (lock_.exchange(true, std::memory_order_acquire)) {
+      spin_wait();
+    }
+  }
+
+  void Unlock() {
+    lock_.store(false, std::memory_order_release);
   }
 
  private:
-  // Your code goes here
-  twist::stdlike::atomic<uint32_t> state_{0};
-  twist::twisted::Futex futex_{state_};
+  // Queue length, read without lock
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+  // Guards queue and chains
+  twist::stdlike::atomic<bool> lock_{false};
+  Node* head_ = nullptr;
+  Node* tail_ = nullptr;
 };
 
 }  // namespace solutions
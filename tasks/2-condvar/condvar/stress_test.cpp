@@ -104,6 +104,10 @@ namespace queue {
   template <typename T>
   class UnboundedBlockingQueue {
    public:
+    // Consumers use short timed waits
+    explicit UnboundedBlockingQueue(bool timed) : timed_(timed) {
+    }
+
     void Enqueue(T item) {
       std::unique_lock lock(mutex_);
       items_.push_back(std::move(item));
@@ -117,7 +121,12 @@ namespace queue {
     T Dequeue() {
       std::unique_lock lock(mutex_);
       while (items_.empty()) {
-        not_empty_.Wait(lock);
+        if (timed_) {
+          not_empty_.WaitFor(lock, std::chrono::microseconds(
+              twist::RandomUInteger(1, 100)));
+        } else {
+          not_empty_.Wait(lock);
+        }
       }
       auto item = items_.front();
       items_.pop_front();
@@ -125,6 +134,7 @@ namespace queue {
     }
 
    private:
+    const bool timed_;
     std::deque<int> items_;
     twist::stdlike::mutex mutex_;
     solutions::ConditionVariable not_empty_;
@@ -135,6 +145,7 @@ namespace queue {
     Tester(const TTestParameters& parameters)
         : parameters_(parameters),
           start_barrier_(parameters.Get(0) + parameters.Get(1)),
+          queue_(parameters.Get(3) != 0),
           producers_left_(parameters.Get(0)) {
     }
 
@@ -209,11 +220,14 @@ void QueueStressTest(TTestParameters parameters) {
   queue::Tester(parameters).Run();
 }
 
+// Parameters: producers, consumers, items, timed waits
 T_TEST_CASES(QueueStressTest)
     .TimeLimit(std::chrono::seconds(30))
-    .Case({5, 1, 10000})
-    .Case({1, 5, 10000})
-    .Case({5, 5, 10000})
-    .Case({10, 10, 10000});
+    .Case({5, 1, 10000, 0})
+    .Case({1, 5, 10000, 0})
+    .Case({5, 5, 10000, 0})
+    .Case({10, 10, 10000, 0})
+    .Case({5, 5, 10000, 1})
+    .Case({10, 10, 10000, 1});
 
 RUN_ALL_TESTS()
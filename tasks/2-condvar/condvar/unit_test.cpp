@@ -7,6 +7,7 @@
 
 #include <atomic>
 #include <chrono>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -97,6 +98,120 @@ TEST_SUITE(CondVar) {
     t2.join();
   }
 
+  SIMPLE_T_TEST(NotifyAllMany) {
+    static const size_t kThreads = 64;
+
+    twist::strand::mutex mutex;
+    solutions::ConditionVariable condvar;
+    bool pass{false};
+    size_t passed = 0;
+
+    auto wait_routine = [&]() {
+      std::unique_lock lock(mutex);
+      while (!pass) {
+        condvar.Wait(lock);
+      }
+      ++passed;
+    };
+
+    std::vector<twist::strand::thread> threads;
+    for (size_t i = 0; i < kThreads; ++i) {
+      threads.emplace_back(wait_routine);
+    }
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(250));
+
+    {
+      std::unique_lock lock(mutex);
+      pass = true;
+      condvar.NotifyAll();
+    }
+
+    for (auto& t : threads) {
+      t.join();
+    }
+    ASSERT_EQ(passed, kThreads);
+  }
+
+  SIMPLE_T_TEST(WaitForTimeout) {
+    twist::strand::mutex mutex;
+    solutions::ConditionVariable condvar;
+
+    std::unique_lock lock(mutex);
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(condvar.WaitFor(lock, 100ms));
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start >= 100ms);
+    ASSERT_TRUE(lock.owns_lock());
+
+    // Timed out waiter has left the queue
+    condvar.NotifyOne();
+  }
+
+  SIMPLE_T_TEST(WaitForNotified) {
+    twist::strand::mutex mutex;
+    solutions::ConditionVariable condvar;
+    bool pass{false};
+
+    twist::strand::thread t([&]() {
+      std::unique_lock lock(mutex);
+      while (!pass) {
+        ASSERT_TRUE(condvar.WaitFor(lock, 10s));
+      }
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+
+    {
+      std::unique_lock lock(mutex);
+      pass = true;
+      condvar.NotifyOne();
+    }
+
+    t.join();
+  }
+
+  SIMPLE_T_TEST(TimeoutInNotifyAllChain) {
+    twist::strand::mutex mutex;
+    solutions::ConditionVariable condvar;
+    bool pass{false};
+
+    auto wait_routine = [&]() {
+      std::unique_lock lock(mutex);
+      while (!pass) {
+        condvar.Wait(lock);
+      }
+    };
+
+    auto timed_routine = [&]() {
+      std::unique_lock lock(mutex);
+      condvar.WaitFor(lock, 50ms);
+    };
+
+    twist::strand::thread t1(wait_routine);
+    twist::strand::thread t2(timed_routine);
+    twist::strand::thread t3(wait_routine);
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(25));
+
+    {
+      // Holds mutex while timed waiter in the middle of queue times out:
+      // it is woken outside of the chain, blocking waiters do not wait
+      // for it
+      std::unique_lock lock(mutex);
+      pass = true;
+      condvar.NotifyAll();
+      twist::strand::this_thread::sleep_for(
+          std::chrono::milliseconds(100));
+    }
+
+    t1.join();
+    t2.join();
+    t3.join();
+  }
+
   SIMPLE_T_TEST(NotifyManyTimes) {
     static const size_t kIterations = 1000 * 1000;
 
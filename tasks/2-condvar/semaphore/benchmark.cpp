@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include "channel.hpp"
+#include "semaphore_channel.hpp"
+#include "spsc_channel.hpp"
+
+#include <thread>
+#include <vector>
+
+// Pipeline throughput: producers -> channel -> consumers
+// Arguments: producers, consumers
+
+static const size_t kItems = 1 << 16;
+static const size_t kCapacity = 1024;
+
+template <typename Channel>
+static void BM_Channel(benchmark::State& state) {
+  const size_t producers = state.range(0);
+  const size_t consumers = state.range(1);
+
+  for (auto _ : state) {
+    Channel channel{kCapacity};
+
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+      threads.emplace_back([&, p]() {
+        for (size_t i = p; i < kItems; i += producers) {
+          channel.Send(i);
+        }
+      });
+    }
+    for (size_t c = 0; c < consumers; ++c) {
+      threads.emplace_back([&, c]() {
+        for (size_t i = c; i < kItems; i += consumers) {
+          benchmark::DoNotOptimize(channel.Receive());
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+#define CHANNEL_BENCHMARK(Channel)        \
+  BENCHMARK_TEMPLATE(BM_Channel, Channel) \
+      ->Args({1, 1})                      \
+      ->Args({4, 1})                      \
+      ->Args({8, 1})                      \
+      ->Args({4, 4})                      \
+      ->Args({8, 8})                      \
+      ->UseRealTime()                     \
+      ->Unit(benchmark::kMillisecond)
+
+CHANNEL_BENCHMARK(solutions::BufferedChannel<size_t>);
+CHANNEL_BENCHMARK(solutions::SemaphoreChannel<size_t>);
+
+BENCHMARK_TEMPLATE(BM_Channel, solutions::SPSCChannel<size_t>)
+    ->Args({1, 1})
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+// Argument: batch size
+
+static void BM_SPSCBatches(benchmark::State& state) {
+  const size_t batch = state.range(0);
+
+  for (auto _ : state) {
+    solutions::SPSCChannel<size_t> channel{kCapacity};
+
+    std::thread producer([&]() {
+      std::vector<size_t> buffer(batch);
+      for (size_t i = 0; i < kItems; i += batch) {
+        for (size_t j = 0; j < batch; ++j) {
+          buffer[j] = i + j;
+        }
+        channel.SendBatch(buffer.data(), batch);
+      }
+    });
+
+    std::vector<size_t> buffer(batch);
+    for (size_t received = 0; received < kItems;) {
+      received += channel.ReceiveBatch(buffer.data(), batch);
+      benchmark::DoNotOptimize(buffer.data());
+    }
+    producer.join();
+  }
+  state.SetItemsProcessed(state.iterations() * kItems);
+}
+
+BENCHMARK(BM_SPSCBatches)
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->UseRealTime()
+    ->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
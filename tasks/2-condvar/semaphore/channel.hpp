@@ -1,45 +1,377 @@
 #pragma once
 
-#include "semaphore.hpp"
+#include "event_count.hpp"
+#include "parking_lot.hpp"
 
-#include <deque>
-#include <iostream>
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/mutex.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
 
 namespace solutions {
 
+// Send to closed channel, Receive from closed and drained one
+struct ChannelClosed : std::runtime_error {
+  ChannelClosed() : std::runtime_error("Channel is closed") {
+  }
+};
+
+namespace detail {
+
+// Blocked Select: one per call, registered in every channel it waits on
+struct Selector {
+  twist::stdlike::atomic<uint32_t> epoch{0};
+
+  void Wait(uint32_t old) {
+    ParkingLot::Wait(epoch, old);
+  }
+
+  void Signal() {
+    epoch.fetch_add(1);
+    ParkingLot::WakeOne(epoch);
+  }
+};
+
+struct SelectorNode {
+  Selector* selector = nullptr;
+  SelectorNode* prev = nullptr;
+  SelectorNode* next = nullptr;
+};
+
+// Selects registered in channel
+class SelectorList {
+ public:
+  void Add(SelectorNode* node) {
+    std::lock_guard guard(mutex_);
+    node->prev = nullptr;
+    node->next = head_;
+    if (head_ != nullptr) {
+      head_->prev = node;
+    }
+    head_ = node;
+    // seq_cst: pairs with count_.load() in SignalAll
+    count_.fetch_add(1);
+  }
+
+  void Remove(SelectorNode* node) {
+    std::lock_guard guard(mutex_);
+    if (node->prev != nullptr) {
+      node->prev->next = node->next;
+    } else {
+      head_ = node->next;
+    }
+    if (node->next != nullptr) {
+      node->next->prev = node->prev;
+    }
+    count_.fetch_sub(1);
+  }
+
+  // Selector is removed under the same lock before Select returns,
+  // so it is alive while we signal it
+  void SignalAll() {
+    if (count_.load() == 0) {
+      return;  // Fast path
+    }
+    std::lock_guard guard(mutex_);
+    for (SelectorNode* node = head_; node != nullptr; node = node->next) {
+      node->selector->Signal();
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> count_{0};
+  twist::stdlike::mutex mutex_;
+  SelectorNode* head_ = nullptr;
+};
+
+}  // namespace detail
+
+template <typename T>
+class BufferedChannel;
+
+// Result of Select: index of the channel and item received from it.
+// Empty item means that channel is closed and drained
+template <typename T>
+struct Selected {
+  size_t index;
+  std::optional<T> item;
+};
+
+template <typename T>
+Selected<T> Select(const std::vector<BufferedChannel<T>*>& channels);
+
+// Bounded MPMC channel on a ring buffer
+// (D. Vyukov, "Bounded MPMC queue")
+
+// Every slot has a sequence number, which tells whose turn it is:
+// - seq == 2 * pos: slot is free for sender with ticket 'pos'
+// - seq == 2 * pos + 1: slot is full for receiver with ticket 'pos'
+// (Doubled: with pos + 1 for full slot, capacity 1 would not tell
+// full slot from free one)
+// Sender / receiver takes a ticket with one CAS and then owns the slot,
+// no other synchronization on the fast path.
+//
+// Blocked senders / receivers wait on event counts:
+// the opposite side notifies them only if someone waits
+//
+// Close sets a flag in the sender position, so every send either took
+// its ticket before Close (and its item will be received) or fails.
+// Channel is drained when closed and receivers took all the tickets
+
 template <typename T>
 class BufferedChannel {
+  struct Slot {
+    twist::stdlike::atomic<uint64_t> seq{0};
+    std::optional<T> item;
+  };
+
+  static const uint64_t kClosed = uint64_t(1) << 63;
+
  public:
-  explicit BufferedChannel(size_t capacity) : queue_is_full_(capacity) {
-    // Not implemented
+  explicit BufferedChannel(size_t capacity)
+      : capacity_(capacity), slots_(std::make_unique<Slot[]>(capacity)) {
+    for (size_t i = 0; i < capacity; ++i) {
+      slots_[i].seq.store(FreeSeq(i), std::memory_order_relaxed);
+    }
   }
 
+  // Blocks while channel is full.
+  // Throws ChannelClosed if channel is closed
   void Send(T item) {
-    queue_is_full_.Acquire();
-    mutex_.Acquire();
-    deque_.push_back(std::move(item));
-    queue_is_empty_.Release();
-    mutex_.Release();
+    while (true) {
+      SendStatus status = TrySend(item);
+      if (status == SendStatus::Sent) {
+        break;
+      }
+      if (status == SendStatus::Closed) {
+        throw ChannelClosed{};
+      }
+      senders_.Await([this]() {
+        return !IsFull() || IsClosed();
+      });
+    }
+    if (IsClosed()) {
+      // Close has raced with this send and may have found no receivers
+      // to wake: the ones that parked since wait for this item or for
+      // drain, and one wakeup is not enough for them
+      receivers_.NotifyAll();
+    } else {
+      receivers_.NotifyOne();
+    }
+    selectors_.SignalAll();
   }
 
+  // Blocks while channel is empty.
+  // Throws ChannelClosed if channel is closed and drained
   T Receive() {
-    // Not implemented
-    queue_is_empty_.Acquire();
-    mutex_.Acquire();
-    auto item = std::move(deque_.front());
-    deque_.pop_front();
-    queue_is_full_.Release();
-    mutex_.Release();
+    while (true) {
+      if (auto item = TryReceive()) {
+        return std::move(*item);
+      }
+      if (IsDrained()) {
+        throw ChannelClosed{};
+      }
+      receivers_.Await([this]() {
+        return !IsEmpty() || IsDrained();
+      });
+    }
+  }
 
+  // Never blocks, returns empty optional if channel is empty
+  std::optional<T> TryReceive() {
+    std::optional<T> item = TryReceiveItem();
+    if (item) {
+      senders_.NotifyOne();
+      if (IsDrained()) {
+        // Took the last item: the others will not get one
+        receivers_.NotifyAll();
+        selectors_.SignalAll();
+      }
+    }
     return item;
   }
 
+  // Subsequent sends fail, receivers get the items sent before Close.
+  // Wakes blocked senders, receivers and selects
+  void Close() {
+    // seq_cst: pairs with PrepareWait of senders and receivers
+    send_pos_.fetch_or(kClosed);
+    senders_.NotifyAll();
+    receivers_.NotifyAll();
+    selectors_.SignalAll();
+  }
+
+  bool IsClosed() const {
+    return (send_pos_.load() & kClosed) != 0;
+  }
+
  private:
-  // Use only semaphores for synchronization
-  solutions::Semaphore queue_is_full_;
-  solutions::Semaphore queue_is_empty_{0};
-  solutions::Semaphore mutex_{1};
-  std::deque<T> deque_;
+  friend Selected<T> Select<T>(const std::vector<BufferedChannel<T>*>&);
+
+  enum class SendStatus {
+    Sent,
+    Full,
+    Closed,
+  };
+
+  // Moves from 'item' only on success
+  SendStatus TrySend(T& item) {
+    uint64_t pos = send_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      if ((pos & kClosed) != 0) {
+        return SendStatus::Closed;
+      }
+      Slot& slot = SlotAt(pos);
+      uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == FreeSeq(pos)) {
+        // Fails if Close has set the flag
+        if (send_pos_.compare_exchange_weak(pos, pos + 1,
+                                            std::memory_order_relaxed)) {
+          slot.item.emplace(std::move(item));
+          // seq_cst: pairs with PrepareWait of receivers
+          slot.seq.store(FullSeq(pos));
+          return SendStatus::Sent;
+        }
+      } else if (seq < FreeSeq(pos)) {
+        // Full: slot still holds item from previous lap
+        return SendStatus::Full;
+      } else {
+        pos = send_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  std::optional<T> TryReceiveItem() {
+    uint64_t pos = receive_pos_.load(std::memory_order_relaxed);
+    while (true) {
+      Slot& slot = SlotAt(pos);
+      uint64_t seq = slot.seq.load(std::memory_order_acquire);
+      if (seq == FullSeq(pos)) {
+        if (receive_pos_.compare_exchange_weak(pos, pos + 1,
+                                               std::memory_order_relaxed)) {
+          std::optional<T> item = std::move(slot.item);
+          slot.item.reset();
+          // seq_cst: pairs with PrepareWait of senders
+          slot.seq.store(FreeSeq(pos + capacity_));
+          return item;
+        }
+      } else if (seq < FullSeq(pos)) {
+        return std::nullopt;  // Empty
+      } else {
+        pos = receive_pos_.load(std::memory_order_relaxed);
+      }
+    }
+  }
+
+  // Slot of next sender is still occupied
+  bool IsFull() const {
+    uint64_t pos = send_pos_.load() & ~kClosed;
+    return SlotAt(pos).seq.load() < FreeSeq(pos);
+  }
+
+  // Slot of next receiver is not filled yet
+  bool IsEmpty() const {
+    uint64_t pos = receive_pos_.load();
+    return SlotAt(pos).seq.load() < FullSeq(pos);
+  }
+
+  // Closed and every sent item is taken by some receiver
+  bool IsDrained() const {
+    uint64_t sent = send_pos_.load();
+    if ((sent & kClosed) == 0) {
+      return false;
+    }
+    return receive_pos_.load() >= (sent & ~kClosed);
+  }
+
+  // Select waits for this
+  bool IsReady() const {
+    return !IsEmpty() || IsDrained();
+  }
+
+  static uint64_t FreeSeq(uint64_t pos) {
+    return pos * 2;
+  }
+
+  static uint64_t FullSeq(uint64_t pos) {
+    return pos * 2 + 1;
+  }
+
+  Slot& SlotAt(uint64_t pos) const {
+    return slots_[pos % capacity_];
+  }
+
+ private:
+  const size_t capacity_;
+  std::unique_ptr<Slot[]> slots_;
+
+  alignas(64) twist::stdlike::atomic<uint64_t> send_pos_{0};
+  alignas(64) twist::stdlike::atomic<uint64_t> receive_pos_{0};
+
+  alignas(64) EventCount senders_;
+  alignas(64) EventCount receivers_;
+  detail::SelectorList selectors_;
 };
 
+// Blocks until one of the channels has an item or is closed and drained.
+// Registers one selector in every channel and parks on it,
+// so it is woken by whichever channel fires first.
+// Starting channel rotates between calls, so no channel starves
+template <typename T>
+Selected<T> Select(const std::vector<BufferedChannel<T>*>& channels) {
+  static thread_local size_t next_start = 0;
+
+  const size_t count = channels.size();
+  const size_t start = next_start++;
+
+  detail::Selector selector;
+  std::vector<detail::SelectorNode> nodes(count);
+
+  while (true) {
+    for (size_t k = 0; k < count; ++k) {
+      size_t index = (start + k) % count;
+      BufferedChannel<T>* channel = channels[index];
+      if (auto item = channel->TryReceive()) {
+        return {index, std::move(item)};
+      }
+      if (channel->IsDrained()) {
+        return {index, std::nullopt};
+      }
+    }
+
+    uint32_t epoch = selector.epoch.load();
+    for (size_t i = 0; i < count; ++i) {
+      nodes[i].selector = &selector;
+      channels[i]->selectors_.Add(&nodes[i]);
+    }
+
+    // Pairs with SignalAll in Send / Close: either we see the item
+    // or sender sees our registration
+    bool ready = false;
+    for (size_t i = 0; i < count && !ready; ++i) {
+      ready = channels[i]->IsReady();
+    }
+    if (!ready) {
+      selector.Wait(epoch);
+    }
+
+    for (size_t i = 0; i < count; ++i) {
+      channels[i]->selectors_.Remove(&nodes[i]);
+    }
+  }
+}
+
+template <typename T>
+Selected<T> Select(std::initializer_list<BufferedChannel<T>*> channels) {
+  return Select(std::vector<BufferedChannel<T>*>(channels));
+}
+
 }  // namespace solutions
@@ -0,0 +1,81 @@
+#pragma once
+
+#include "parking_lot.hpp"
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <cstdint>
+
+namespace solutions {
+
+// Event count: blocking for lock-free structures
+// (Folly EventCount, D. Vyukov eventcount)
+
+// Waiter announces itself, re-checks its condition, and only then
+// sleeps: no wakeup is lost between the check and the sleep.
+//
+//   while (!ready()) {
+//     auto key = event_count.PrepareWait();
+//     if (ready()) {
+//       event_count.CancelWait();
+//       break;
+//     }
+//     event_count.CommitWait(key);
+//   }
+//
+// Notifier changes the condition and then calls Notify*: a single load
+// when nobody waits. Sleeping is done in ParkingLot, so woken but not
+// yet running waiters cost notifier no syscalls
+
+class EventCount {
+ public:
+  using Key = uint32_t;
+
+  Key PrepareWait() {
+    waiters_.fetch_add(1);
+    // Pairs with waiters_.load() in Notify*: either waiter
+    // sees the change or notifier sees waiter
+    return epoch_.load();
+  }
+
+  void CancelWait() {
+    waiters_.fetch_sub(1);
+  }
+
+  // Blocks until notification after PrepareWait that returned 'key'
+  void CommitWait(Key key) {
+    ParkingLot::Wait(epoch_, key);
+    waiters_.fetch_sub(1);
+  }
+
+  void NotifyOne() {
+    if (waiters_.load() > 0) {
+      epoch_.fetch_add(1);
+      ParkingLot::WakeOne(epoch_);
+    }
+  }
+
+  void NotifyAll() {
+    if (waiters_.load() > 0) {
+      epoch_.fetch_add(1);
+      ParkingLot::WakeAll(epoch_);
+    }
+  }
+
+  // Waits until Notify* if 'ready' still returns false
+  template <typename Ready>
+  void Await(Ready ready) {
+    Key key = PrepareWait();
+    if (ready()) {
+      CancelWait();
+    } else {
+      CommitWait(key);
+    }
+  }
+
+ private:
+  twist::stdlike::atomic<uint32_t> waiters_{0};
+  twist::stdlike::atomic<uint32_t> epoch_{0};
+};
+
+}  // namespace solutions
@@ -0,0 +1,318 @@
+#pragma once
+
+#include <twist/stdlike/atomic.hpp>
+#include <twist/stdlike/thread.hpp>
+#include <twist/strand/spin_wait.hpp>
+#include <twist/twisted/futex.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace solutions {
+
+// Address-keyed parking lot (WebKit WTF::ParkingLot)
+
+// Thread can park on any address: no futex inside the waited object.
+// Parked threads live in a global hash table of buckets, each bucket is
+// a spinlock and a FIFO queue. Parking validates the condition under
+// bucket lock, unparking takes the same lock, so no wakeup is lost.
+// Every parked thread sleeps on its own futex word, so unparking wakes
+// exactly the threads it takes from the queue.
+//
+// Parked thread may leave a token (e.g. what it waits for), unparker
+// can look at the tokens and choose whom to wake.
+//
+// Timed parking queues up with the others, but futex wait has no
+// timeout: timed waiter polls its word with sleeps of at most
+// kMaxPollInterval, so it notices unparking up to that late
+
+class ParkingLot {
+  struct Parked {
+    twist::stdlike::atomic<uint32_t> unparked{0};
+    twist::twisted::Futex futex{unparked};
+    const void* address = nullptr;
+    uintptr_t token = 0;
+    Parked* next = nullptr;
+  };
+
+  struct alignas(64) Bucket {
+    twist::stdlike::atomic<bool> locked{false};
+    Parked* head = nullptr;
+    Parked* tail = nullptr;
+
+    void Lock() {
+      twist::strand::SpinWait spin_wait;
+      while (locked.exchange(true, std::memory_order_acquire)) {
+        spin_wait();
+      }
+    }
+
+    void Unlock() {
+      locked.store(false, std::memory_order_release);
+    }
+
+    void Enqueue(Parked* node) {
+      if (tail != nullptr) {
+        tail->next = node;
+      } else {
+        head = node;
+      }
+      tail = node;
+    }
+
+    // Removes first node parked on 'address', if any
+    Parked* Dequeue(const void* address) {
+      Parked* prev = nullptr;
+      for (Parked* node = head; node != nullptr; node = node->next) {
+        if (node->address == address) {
+          Unlink(prev, node);
+          return node;
+        }
+        prev = node;
+      }
+      return nullptr;
+    }
+
+    // Returns false if node is not in queue
+    bool Remove(Parked* node) {
+      Parked* prev = nullptr;
+      for (Parked* curr = head; curr != nullptr; curr = curr->next) {
+        if (curr == node) {
+          Unlink(prev, node);
+          return true;
+        }
+        prev = curr;
+      }
+      return false;
+    }
+
+    bool Contains(const void* address) const {
+      for (Parked* node = head; node != nullptr; node = node->next) {
+        if (node->address == address) {
+          return true;
+        }
+      }
+      return false;
+    }
+
+    void Unlink(Parked* prev, Parked* node) {
+      if (prev != nullptr) {
+        prev->next = node->next;
+      } else {
+        head = node->next;
+      }
+      if (tail == node) {
+        tail = prev;
+      }
+      node->next = nullptr;
+    }
+  };
+
+  static const size_t kBucketBits = 8;
+  static const size_t kBuckets = 1 << kBucketBits;
+
+  static constexpr std::chrono::microseconds kMaxPollInterval{256};
+
+ public:
+  enum class ParkResult {
+    Unparked,
+    Invalid,  // Validation failed
+    TimedOut,
+  };
+
+  struct UnparkResult {
+    bool unparked;
+    // Other threads are still parked on the same address
+    bool may_have_more;
+  };
+
+  // Parks current thread on 'address' if 'validate()', called under
+  // bucket lock, returns true. Returns false if validation failed
+  template <typename Validate>
+  static bool Park(const void* address, Validate validate,
+                   uintptr_t token = 0) {
+    Bucket& bucket = BucketFor(address);
+
+    Parked node;
+    node.address = address;
+    node.token = token;
+
+    bucket.Lock();
+    if (!validate()) {
+      bucket.Unlock();
+      return false;
+    }
+    bucket.Enqueue(&node);
+    bucket.Unlock();
+
+    while (node.unparked.load() == 0) {
+      node.futex.Wait(0);
+    }
+
+    // Unparker wakes us under bucket lock:
+    // wait until it leaves before destroying node
+    bucket.Lock();
+    bucket.Unlock();
+    return true;
+  }
+
+  // Park with deadline
+  template <typename Validate, typename Clock, typename Duration>
+  static ParkResult ParkUntil(
+      const void* address, Validate validate,
+      std::chrono::time_point<Clock, Duration> deadline,
+      uintptr_t token = 0) {
+    Bucket& bucket = BucketFor(address);
+
+    Parked node;
+    node.address = address;
+    node.token = token;
+
+    bucket.Lock();
+    if (!validate()) {
+      bucket.Unlock();
+      return ParkResult::Invalid;
+    }
+    bucket.Enqueue(&node);
+    bucket.Unlock();
+
+    std::chrono::microseconds backoff{1};
+
+    while (node.unparked.load() == 0) {
+      auto now = Clock::now();
+      if (now >= deadline) {
+        bucket.Lock();
+        // Not in queue: unparker has taken us, wakeup is ours
+        bool removed = bucket.Remove(&node);
+        bucket.Unlock();
+        return removed ? ParkResult::TimedOut : ParkResult::Unparked;
+      }
+      auto remains =
+          std::chrono::duration_cast<std::chrono::microseconds>(deadline - now);
+      twist::stdlike::this_thread::sleep_for(std::min(backoff, remains));
+      if (backoff < kMaxPollInterval) {
+        backoff *= 2;
+      }
+    }
+
+    bucket.Lock();
+    bucket.Unlock();
+    return ParkResult::Unparked;
+  }
+
+  // Unparks the oldest thread parked on 'address'.
+  // 'callback(result)' runs under bucket lock: e.g. to clear
+  // "has parked" flag when nobody is left
+  template <typename Callback>
+  static void UnparkOne(const void* address, Callback callback) {
+    Bucket& bucket = BucketFor(address);
+
+    bucket.Lock();
+    Parked* node = bucket.Dequeue(address);
+    UnparkResult result{node != nullptr, bucket.Contains(address)};
+    callback(result);
+    if (node != nullptr) {
+      Wake(node);
+    }
+    bucket.Unlock();
+  }
+
+  static void UnparkOne(const void* address) {
+    UnparkOne(address, [](UnparkResult) {});
+  }
+
+  // Returns number of unparked threads
+  static size_t UnparkAll(const void* address) {
+    Bucket& bucket = BucketFor(address);
+
+    size_t count = 0;
+    bucket.Lock();
+    while (Parked* node = bucket.Dequeue(address)) {
+      Wake(node);
+      ++count;
+    }
+    bucket.Unlock();
+    return count;
+  }
+
+  // Walks threads parked on 'address' from the oldest one, unparks
+  // those for which 'filter(token)' returns true and skips the rest.
+  // 'filter' runs under bucket lock. Returns number of unparked threads
+  template <typename Filter>
+  static size_t UnparkFiltered(const void* address, Filter filter) {
+    Bucket& bucket = BucketFor(address);
+
+    size_t count = 0;
+    bucket.Lock();
+    Parked* prev = nullptr;
+    Parked* node = bucket.head;
+    while (node != nullptr) {
+      Parked* next = node->next;
+      if (node->address == address && filter(node->token)) {
+        bucket.Unlink(prev, node);
+        Wake(node);
+        ++count;
+      } else {
+        prev = node;
+      }
+      node = next;
+    }
+    bucket.Unlock();
+    return count;
+  }
+
+  // Futex on any 32-bit atomic word
+
+  // Blocks while 'word' holds 'old' (or until woken)
+  static void Wait(const twist::stdlike::atomic<uint32_t>& word,
+                   uint32_t old, uintptr_t token = 0) {
+    Park(
+        &word,
+        [&]() {
+          return word.load() == old;
+        },
+        token);
+  }
+
+  // Returns false on timeout
+  template <typename Clock, typename Duration>
+  static bool WaitUntil(const twist::stdlike::atomic<uint32_t>& word,
+                        uint32_t old,
+                        std::chrono::time_point<Clock, Duration> deadline,
+                        uintptr_t token = 0) {
+    auto result = ParkUntil(
+        &word,
+        [&]() {
+          return word.load() == old;
+        },
+        deadline, token);
+    return result != ParkResult::TimedOut;
+  }
+
+  static void WakeOne(const twist::stdlike::atomic<uint32_t>& word) {
+    UnparkOne(&word);
+  }
+
+  static void WakeAll(const twist::stdlike::atomic<uint32_t>& word) {
+    UnparkAll(&word);
+  }
+
+ private:
+  static Bucket& BucketFor(const void* address) {
+    static Bucket buckets[kBuckets];
+
+    uintptr_t key = reinterpret_cast<uintptr_t>(address);
+    // Fibonacci hashing: neighbouring words go to different buckets
+    key = (key >> 2) * 11400714819323198485ull;
+    return buckets[key >> (64 - kBucketBits)];
+  }
+
+  static void Wake(Parked* node) {
+    node->unparked.store(1);
+    node->futex.WakeOne();
+  }
+};
+
+}  // namespace solutions
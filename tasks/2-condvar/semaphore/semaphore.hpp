@@ -1,38 +1,143 @@
 #pragma once
 
-#include <twist/stdlike/mutex.hpp>
-#include <twist/stdlike/condition_variable.hpp>
+#include "parking_lot.hpp"
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 
 namespace solutions {
 
+// Counting semaphore on a single atomic counter of permits
+
+// Acquire takes permits with CAS while there are enough of them,
+// parks on the counter (ParkingLot) only when there are not, leaving
+// the number of permits it wants as parking token.
+// Release does not touch ParkingLot unless someone waits. Otherwise
+// it walks parked waiters in FIFO order once and wakes those whose
+// demands fit into available permits: no thundering herd.
+//
+// Multi-permit acquires are all-or-nothing: thread never holds
+// part of the permits it asked for
+
 class Semaphore {
  public:
-  explicit Semaphore(size_t initial_count) {
-    // Not implemented
-    count_of_tickets_ = initial_count;
+  explicit Semaphore(size_t initial_count)
+      : permits_(static_cast<uint32_t>(initial_count)) {
+  }
+
+  void Acquire(size_t count = 1) {
+    if (TryAcquire(count)) {
+      return;  // Fast path
+    }
+    AcquireSlow(static_cast<uint32_t>(count));
+  }
+
+  bool TryAcquire(size_t count = 1) {
+    uint32_t permits = permits_.load();
+    while (permits >= count) {
+      if (permits_.compare_exchange_weak(permits,
+                                         permits - (uint32_t)count)) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Timed waiters queue up with blocking ones and get permits
+  // in turn, but they poll for wakeup (see ParkingLot::ParkUntil):
+  // release handed to a timed waiter is taken up to ~256us late
+  template <typename Rep, typename Period>
+  bool TryAcquireFor(std::chrono::duration<Rep, Period> timeout,
+                     size_t count = 1) {
+    if (TryAcquire(count)) {
+      return true;  // Fast path
+    }
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    return AcquireSlow(static_cast<uint32_t>(count), [&](uint32_t permits) {
+      return ParkingLot::WaitUntil(permits_, permits, deadline, count);
+    });
+  }
+
+  void Release(size_t count = 1) {
+    permits_.fetch_add(static_cast<uint32_t>(count));
+    // Pairs with waiters_ increment in AcquireSlow: either waiter
+    // sees new permits or we see waiter
+    if (waiters_.load() == 0) {
+      return;
+    }
+    UnparkFitting();
   }
 
-  void Acquire() {
-    // Not implemented
-    std::unique_lock<twist::stdlike::mutex> lock(mutex_);
-    while (count_of_tickets_ == 0) {
-      semaphore_not_empty_.wait(lock);
+ private:
+  // Wakes parked waiters in FIFO order while their demands fit into
+  // available permits. Waiter that does not fit is skipped, smaller
+  // ones behind it still get permits.
+  // Waiter that validates its parking under bucket lock sees permits
+  // loaded here, so budget covers every waiter that stays parked
+  void UnparkFitting() {
+    uint32_t budget = permits_.load();
+    if (budget == 0) {
+      return;
     }
-    count_of_tickets_--;
+    ParkingLot::UnparkFiltered(&permits_, [&budget](uintptr_t demand) {
+      if (demand > budget) {
+        return false;
+      }
+      budget -= static_cast<uint32_t>(demand);
+      return true;
+    });
   }
 
-  void Release() {
-    // Not implemented
-    std::unique_lock<twist::stdlike::mutex> lock(mutex_);
-    count_of_tickets_++;
-    semaphore_not_empty_.notify_one();
+  void AcquireSlow(uint32_t count) {
+    AcquireSlow(count, [&](uint32_t permits) {
+      ParkingLot::Wait(permits_, permits, count);
+      return true;
+    });
+  }
+
+  // park(permits) returns false on timeout
+  template <typename Park>
+  bool AcquireSlow(uint32_t count, Park park) {
+    bool acquired = false;
+    bool woken = false;
+
+    waiters_.fetch_add(1);
+    while (true) {
+      uint32_t permits = permits_.load();
+      if (permits >= count) {
+        if (permits_.compare_exchange_weak(permits, permits - count)) {
+          acquired = true;
+          break;
+        }
+        continue;
+      }
+      if (woken && permits > 0) {
+        // Release chose us, but someone else took (part of) the permits
+        // meanwhile. Waiters skipped in our favour may fit in the rest
+        UnparkFitting();
+      }
+      // Returns immediately if permits changed since load
+      if (!park(permits)) {
+        // Last chance: release may have raced with timeout
+        acquired = TryAcquire(count);
+        break;
+      }
+      woken = true;
+    }
+    waiters_.fetch_sub(1);
+    if (!acquired) {
+      // Timed out after being chosen: pass the permits on
+      UnparkFitting();
+    }
+    return acquired;
   }
 
  private:
-  // Your code goes here
-  twist::stdlike::mutex mutex_;
-  twist::stdlike::condition_variable semaphore_not_empty_;
-  size_t count_of_tickets_;
+  twist::stdlike::atomic<uint32_t> permits_;
+  twist::stdlike::atomic<uint32_t> waiters_{0};
 };
 
 }  // namespace solutions
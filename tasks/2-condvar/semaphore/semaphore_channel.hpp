@@ -0,0 +1,43 @@
+#pragma once
+
+#include "semaphore.hpp"
+
+#include <deque>
+
+namespace solutions {
+
+// Channel built from semaphores only: baseline for BufferedChannel
+
+template <typename T>
+class SemaphoreChannel {
+ public:
+  explicit SemaphoreChannel(size_t capacity) : queue_is_full_(capacity) {
+  }
+
+  void Send(T item) {
+    queue_is_full_.Acquire();
+    mutex_.Acquire();
+    deque_.push_back(std::move(item));
+    queue_is_empty_.Release();
+    mutex_.Release();
+  }
+
+  T Receive() {
+    queue_is_empty_.Acquire();
+    mutex_.Acquire();
+    auto item = std::move(deque_.front());
+    deque_.pop_front();
+    queue_is_full_.Release();
+    mutex_.Release();
+
+    return item;
+  }
+
+ private:
+  solutions::Semaphore queue_is_full_;
+  solutions::Semaphore queue_is_empty_{0};
+  solutions::Semaphore mutex_{1};
+  std::deque<T> deque_;
+};
+
+}  // namespace solutions
@@ -0,0 +1,167 @@
+#pragma once
+
+#include "event_count.hpp"
+
+#include <twist/stdlike/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <utility>
+
+namespace solutions {
+
+// Bounded channel for exactly one sender thread
+// and one receiver thread
+
+// Ring buffer with power-of-two capacity (rounded up).
+// Sender owns 'tail', receiver owns 'head', each on its own cache line.
+// Each side keeps a local copy of the opposite index and re-reads the
+// shared one only when the copy says the ring is full (empty), so the
+// fast path touches no cache line written by the other side.
+//
+// Batch operations publish many items with one index update.
+// Sender (receiver) waits on event count only when ring is full (empty)
+
+template <typename T>
+class SPSCChannel {
+ public:
+  explicit SPSCChannel(size_t capacity)
+      : capacity_(RoundUpToPowerOfTwo(capacity)),
+        mask_(capacity_ - 1),
+        slots_(std::make_unique<std::optional<T>[]>(capacity_)) {
+  }
+
+  size_t Capacity() const {
+    return capacity_;
+  }
+
+  // Sender
+
+  // Blocks while channel is full
+  void Send(T item) {
+    uint64_t tail = tail_.load(std::memory_order_relaxed);
+    WaitForSpace(tail);
+    SlotAt(tail).emplace(std::move(item));
+    Publish(tail + 1);
+  }
+
+  // Moves 'count' items from 'items' to channel, blocks until all are sent
+  void SendBatch(T* items, size_t count) {
+    while (count > 0) {
+      uint64_t tail = tail_.load(std::memory_order_relaxed);
+      size_t batch = std::min(WaitForSpace(tail), count);
+      for (size_t i = 0; i < batch; ++i) {
+        SlotAt(tail + i).emplace(std::move(items[i]));
+      }
+      Publish(tail + batch);
+      items += batch;
+      count -= batch;
+    }
+  }
+
+  // Receiver
+
+  // Blocks while channel is empty
+  T Receive() {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    WaitForItems(head);
+    T item = TakeAt(head);
+    Consume(head + 1);
+    return item;
+  }
+
+  // Blocks while channel is empty, then moves up to 'max_count' items
+  // to 'items'. Returns number of received items
+  size_t ReceiveBatch(T* items, size_t max_count) {
+    uint64_t head = head_.load(std::memory_order_relaxed);
+    size_t batch = std::min(WaitForItems(head), max_count);
+    for (size_t i = 0; i < batch; ++i) {
+      items[i] = TakeAt(head + i);
+    }
+    Consume(head + batch);
+    return batch;
+  }
+
+ private:
+  static size_t RoundUpToPowerOfTwo(size_t value) {
+    size_t power = 1;
+    while (power < value) {
+      power *= 2;
+    }
+    return power;
+  }
+
+  std::optional<T>& SlotAt(uint64_t index) {
+    return slots_[index & mask_];
+  }
+
+  T TakeAt(uint64_t index) {
+    std::optional<T>& slot = SlotAt(index);
+    T item = std::move(*slot);
+    slot.reset();
+    return item;
+  }
+
+  // Returns number of free slots (> 0)
+  size_t WaitForSpace(uint64_t tail) {
+    if (tail - cached_head_ < capacity_) {
+      return capacity_ - (tail - cached_head_);  // Fast path
+    }
+    cached_head_ = head_.load(std::memory_order_acquire);
+    while (tail - cached_head_ == capacity_) {
+      sender_.Await([&]() {
+        return tail - head_.load() < capacity_;
+      });
+      cached_head_ = head_.load(std::memory_order_acquire);
+    }
+    return capacity_ - (tail - cached_head_);
+  }
+
+  // Returns number of available items (> 0)
+  size_t WaitForItems(uint64_t head) {
+    if (cached_tail_ != head) {
+      return cached_tail_ - head;  // Fast path
+    }
+    cached_tail_ = tail_.load(std::memory_order_acquire);
+    while (cached_tail_ == head) {
+      receiver_.Await([&]() {
+        return tail_.load() != head;
+      });
+      cached_tail_ = tail_.load(std::memory_order_acquire);
+    }
+    return cached_tail_ - head;
+  }
+
+  void Publish(uint64_t tail) {
+    // seq_cst: pairs with PrepareWait of receiver
+    tail_.store(tail);
+    receiver_.NotifyOne();
+  }
+
+  void Consume(uint64_t head) {
+    // seq_cst: pairs with PrepareWait of sender
+    head_.store(head);
+    sender_.NotifyOne();
+  }
+
+ private:
+  const size_t capacity_;
+  const size_t mask_;
+  std::unique_ptr<std::optional<T>[]> slots_;
+
+  // Sender
+  alignas(64) twist::stdlike::atomic<uint64_t> tail_{0};
+  uint64_t cached_head_ = 0;
+
+  // Receiver
+  alignas(64) twist::stdlike::atomic<uint64_t> head_{0};
+  uint64_t cached_tail_ = 0;
+
+  alignas(64) EventCount sender_;
+  alignas(64) EventCount receiver_;
+};
+
+}  // namespace solutions
@@ -1,5 +1,7 @@
 #include "semaphore.hpp"
 #include "channel.hpp"
+#include "spsc_channel.hpp"
+#include "event_count.hpp"
 
 #include <twist/test_framework/test_framework.hpp>
 #include <twist/strand/test.hpp>
@@ -11,6 +13,9 @@
 
 #include <twist/fault/adversary/inject_fault.hpp>
 
+#include <twist/support/random.hpp>
+
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -141,6 +146,100 @@ T_TEST_CASES(PingPongStressTest)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+void BudgetStressTest(const TTestParameters& parameters) {
+  size_t threads = parameters.Get(0);
+  twist::test_utils::OnePassBarrier start_barrier{threads};
+
+  size_t budget = parameters.Get(1);
+  solutions::Semaphore semaphore{budget};
+  std::atomic<int> available{(int)budget};
+
+  auto test_routine = [&]() {
+    start_barrier.PassThrough();
+
+    size_t iterations = parameters.Get(2);
+    for (size_t i = 0; i < iterations; ++i) {
+      size_t request = twist::RandomUInteger(1, budget);
+      semaphore.Acquire(request);
+      ASSERT_TRUE(available.fetch_sub((int)request) >= (int)request);
+      twist::fault::InjectFault();
+      available.fetch_add((int)request);
+      semaphore.Release(request);
+    }
+  };
+
+  twist::test_utils::ScopedExecutor executor;
+  for (size_t t = 0; t < threads; ++t) {
+    executor.Submit(test_routine);
+  }
+  executor.Join();
+
+  ASSERT_TRUE(semaphore.TryAcquire(budget));
+}
+
+// Parameters: threads, budget, iterations
+T_TEST_CASES(BudgetStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({2, 3, 50000})
+    .Case({5, 10, 20000})
+    .Case({10, 100, 10000});
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Consumers wait on event count for a shared counter to grow
+void EventCountStressTest(const TTestParameters& parameters) {
+  size_t consumers = parameters.Get(0);
+  size_t iterations = parameters.Get(1);
+
+  solutions::EventCount event_count;
+  std::atomic<size_t> produced{0};
+  std::atomic<size_t> consumed{0};
+
+  auto consumer = [&]() {
+    while (true) {
+      size_t taken = consumed.load();
+      if (taken == iterations) {
+        break;
+      }
+      if (taken < produced.load()) {
+        if (consumed.compare_exchange_weak(taken, taken + 1) &&
+            taken + 1 == iterations) {
+          event_count.NotifyAll();  // Release the rest
+        }
+        continue;
+      }
+      event_count.Await([&]() {
+        return consumed.load() < produced.load() ||
+               consumed.load() == iterations;
+      });
+    }
+  };
+
+  twist::test_utils::ScopedExecutor executor;
+  for (size_t i = 0; i < consumers; ++i) {
+    executor.Submit(consumer);
+  }
+
+  for (size_t i = 0; i < iterations; ++i) {
+    produced.fetch_add(1);
+    if (twist::TossFairCoin()) {
+      event_count.NotifyOne();
+    } else {
+      event_count.NotifyAll();
+    }
+    twist::fault::InjectFault();
+  }
+}
+
+// Parameters: consumers, iterations
+T_TEST_CASES(EventCountStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({1, 50000})
+    .Case({4, 50000})
+    .Case({10, 20000});
+
+////////////////////////////////////////////////////////////////////////////////
+
 namespace channel {
 
 class Tester {
@@ -224,4 +323,157 @@ T_TEST_CASES(ChannelStressTest)
 
 ////////////////////////////////////////////////////////////////////////////////
 
+// Producers close their channels, aggregator selects until all are drained
+void SelectStressTest(const TTestParameters& parameters) {
+  size_t producers = parameters.Get(0);
+  size_t items = parameters.Get(1);
+
+  std::vector<std::unique_ptr<solutions::BufferedChannel<size_t>>> channels;
+  for (size_t i = 0; i < producers; ++i) {
+    channels.push_back(std::make_unique<solutions::BufferedChannel<size_t>>(
+        parameters.Get(2)));
+  }
+
+  twist::test_utils::ScopedExecutor executor;
+  for (size_t t = 0; t < producers; ++t) {
+    executor.Submit([&, t]() {
+      for (size_t i = 0; i < items; ++i) {
+        channels[t]->Send(i);
+      }
+      channels[t]->Close();
+    });
+  }
+
+  std::vector<solutions::BufferedChannel<size_t>*> open;
+  std::vector<size_t> next(producers, 0);
+  std::vector<size_t> owner;
+  for (size_t t = 0; t < producers; ++t) {
+    open.push_back(channels[t].get());
+    owner.push_back(t);
+  }
+
+  while (!open.empty()) {
+    auto selected = solutions::Select(open);
+    size_t producer = owner[selected.index];
+    if (selected.item) {
+      // Per-channel FIFO
+      ASSERT_EQ(*selected.item, next[producer]++);
+    } else {
+      open.erase(open.begin() + selected.index);
+      owner.erase(owner.begin() + selected.index);
+    }
+  }
+
+  for (size_t t = 0; t < producers; ++t) {
+    ASSERT_EQ(next[t], items);
+  }
+}
+
+// Parameters: producers, items per producer, channel capacity
+T_TEST_CASES(SelectStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({1, 50000, 1})
+    .Case({3, 20000, 2})
+    .Case({8, 10000, 16});
+
+////////////////////////////////////////////////////////////////////////////////
+
+// Receivers block while Close races with in-flight sends:
+// every receiver must wake up and see the channel drained
+void CloseStressTest(const TTestParameters& parameters) {
+  size_t producers = parameters.Get(0);
+  size_t consumers = parameters.Get(1);
+  size_t rounds = parameters.Get(2);
+
+  for (size_t round = 0; round < rounds; ++round) {
+    solutions::BufferedChannel<size_t> channel{parameters.Get(3)};
+
+    twist::stdlike::atomic<size_t> sent{0};
+    twist::stdlike::atomic<size_t> received{0};
+
+    twist::test_utils::ScopedExecutor executor;
+
+    for (size_t t = 0; t < consumers; ++t) {
+      executor.Submit([&]() {
+        try {
+          while (true) {
+            channel.Receive();
+            received.fetch_add(1);
+          }
+        } catch (solutions::ChannelClosed&) {
+          ASSERT_TRUE(channel.IsClosed());
+        }
+      });
+    }
+
+    for (size_t t = 0; t < producers; ++t) {
+      executor.Submit([&, t]() {
+        try {
+          for (size_t i = 0;; ++i) {
+            channel.Send(i);
+            sent.fetch_add(1);
+            if (t == 0 && i == round % 7) {
+              channel.Close();
+            }
+          }
+        } catch (solutions::ChannelClosed&) {
+        }
+      });
+    }
+
+    executor.Join();
+
+    ASSERT_EQ(sent.load(), received.load());
+  }
+}
+
+// Parameters: producers, consumers, rounds, channel capacity
+T_TEST_CASES(CloseStressTest)
+    .TimeLimit(std::chrono::seconds(60))
+    .Case({1, 2, 5000, 1})
+    .Case({3, 3, 3000, 2})
+    .Case({4, 8, 2000, 4});
+
+////////////////////////////////////////////////////////////////////////////////
+
+void SPSCChannelStressTest(const TTestParameters& parameters) {
+  size_t items = parameters.Get(0);
+  size_t batch = parameters.Get(2);
+
+  solutions::SPSCChannel<size_t> channel{parameters.Get(1)};
+
+  twist::test_utils::ScopedExecutor executor;
+
+  executor.Submit([&]() {
+    std::vector<size_t> buffer;
+    for (size_t i = 0; i < items; ++i) {
+      buffer.push_back(i);
+      if (buffer.size() == batch) {
+        channel.SendBatch(buffer.data(), buffer.size());
+        buffer.clear();
+      }
+    }
+    channel.SendBatch(buffer.data(), buffer.size());
+  });
+
+  std::vector<size_t> buffer(batch);
+  size_t next = 0;
+  while (next < items) {
+    size_t count = channel.ReceiveBatch(buffer.data(), batch);
+    for (size_t i = 0; i < count; ++i) {
+      ASSERT_EQ(buffer[i], next++);
+    }
+  }
+}
+
+// Parameters: items, channel capacity, batch size
+T_TEST_CASES(SPSCChannelStressTest)
+    .TimeLimit(std::chrono::seconds(30))
+    .Case({100000, 1, 1})
+    .Case({100000, 4, 1})
+    .Case({100000, 4, 3})
+    .Case({100000, 64, 16});
+
+////////////////////////////////////////////////////////////////////////////////
+
 RUN_ALL_TESTS()
@@ -1,5 +1,8 @@
 #include "semaphore.hpp"
 #include "channel.hpp"
+#include "spsc_channel.hpp"
+#include "event_count.hpp"
+#include "parking_lot.hpp"
 
 #include <twist/test_framework/test_framework.hpp>
 #include <twist/strand/test.hpp>
@@ -14,6 +17,7 @@
 #include <deque>
 #include <chrono>
 #include <string>
+#include <vector>
 
 TEST_SUITE(Semaphore) {
   SIMPLE_T_TEST(NonBlocking) {
@@ -76,6 +80,319 @@ TEST_SUITE(Semaphore) {
 
     opponent.join();
   }
+
+  SIMPLE_T_TEST(MultiplePermits) {
+    solutions::Semaphore semaphore(5);
+
+    semaphore.Acquire(3);
+    ASSERT_FALSE(semaphore.TryAcquire(3));
+    ASSERT_TRUE(semaphore.TryAcquire(2));
+    ASSERT_FALSE(semaphore.TryAcquire());
+
+    semaphore.Release(5);
+    ASSERT_TRUE(semaphore.TryAcquire(5));
+  }
+
+  SIMPLE_T_TEST(ReleaseWakesMany) {
+    static const size_t kThreads = 4;
+
+    solutions::Semaphore semaphore(0);
+    std::atomic<size_t> acquired{0};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t i = 0; i < kThreads; ++i) {
+      executor.Submit([&, i]() {
+        semaphore.Acquire(i + 1);
+        acquired.fetch_add(i + 1);
+      });
+    }
+
+    twist::strand::this_thread::sleep_for(std::chrono::milliseconds(100));
+    ASSERT_EQ(acquired.load(), 0);
+
+    semaphore.Release(1 + 2 + 3 + 4);
+    executor.Join();
+
+    ASSERT_EQ(acquired.load(), 10);
+    ASSERT_FALSE(semaphore.TryAcquire());
+  }
+
+  SIMPLE_T_TEST(SmallWaiterBehindLargeOne) {
+    solutions::Semaphore semaphore(0);
+
+    std::atomic<bool> small_done{false};
+
+    twist::strand::thread large([&]() {
+      semaphore.Acquire(5);
+    });
+    twist::strand::thread small([&]() {
+      semaphore.Acquire(1);
+      small_done.store(true);
+    });
+
+    twist::strand::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+    // Wakeup should not be lost on large waiter
+    semaphore.Release(1);
+    small.join();
+    ASSERT_TRUE(small_done.load());
+
+    semaphore.Release(5);
+    large.join();
+  }
+
+  SIMPLE_T_TEST(ReleaseWakesFittingWaiters) {
+    solutions::Semaphore semaphore(0);
+    std::atomic<size_t> acquired{0};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t count : {3, 1, 1}) {
+      executor.Submit([&, count]() {
+        semaphore.Acquire(count);
+        acquired.fetch_add(count);
+      });
+      twist::strand::this_thread::sleep_for(std::chrono::milliseconds(50));
+    }
+
+    // Large waiter at the head does not fit, small ones behind it do
+    semaphore.Release(2);
+    while (acquired.load() < 2) {
+      twist::strand::this_thread::yield();
+    }
+    twist::strand::this_thread::sleep_for(std::chrono::milliseconds(50));
+    ASSERT_EQ(acquired.load(), 2);
+
+    semaphore.Release(3);
+    executor.Join();
+    ASSERT_EQ(acquired.load(), 5);
+  }
+
+  SIMPLE_T_TEST(TryAcquireFor) {
+    using namespace std::chrono_literals;
+
+    solutions::Semaphore semaphore(1);
+
+    ASSERT_TRUE(semaphore.TryAcquireFor(100ms));
+    ASSERT_FALSE(semaphore.TryAcquireFor(100ms));
+
+    twist::strand::thread releaser([&]() {
+      twist::strand::this_thread::sleep_for(100ms);
+      semaphore.Release(3);
+    });
+
+    ASSERT_TRUE(semaphore.TryAcquireFor(10s, 3));
+    releaser.join();
+  }
+
+  SIMPLE_T_TEST(TimedWaiterIsQueued) {
+    using namespace std::chrono_literals;
+
+    solutions::Semaphore semaphore(0);
+    twist::stdlike::atomic<bool> blocking_done{false};
+
+    twist::strand::thread timed([&]() {
+      ASSERT_TRUE(semaphore.TryAcquireFor(10s));
+      // Blocking waiter came later
+      ASSERT_FALSE(blocking_done.load());
+      semaphore.Release();
+    });
+
+    twist::strand::this_thread::sleep_for(100ms);
+
+    twist::strand::thread blocking([&]() {
+      semaphore.Acquire();
+      blocking_done.store(true);
+    });
+
+    twist::strand::this_thread::sleep_for(100ms);
+
+    // Goes to the first waiter
+    semaphore.Release();
+
+    timed.join();
+    blocking.join();
+  }
+
+#if !defined(TWIST_FIBER)
+
+  SIMPLE_T_TEST(NoWaitersNoFutexes) {
+    static const size_t kIterations = 1000;
+
+    size_t futex_calls = twist::thread::FutexCallCount();
+
+    solutions::Semaphore semaphore(1);
+    for (size_t i = 0; i < kIterations; ++i) {
+      semaphore.Acquire();
+      semaphore.Release();
+      semaphore.Release();
+      semaphore.Acquire();
+    }
+
+    ASSERT_EQ(futex_calls, twist::thread::FutexCallCount());
+  }
+
+#endif
+}
+
+TEST_SUITE(ParkingLot) {
+  SIMPLE_T_TEST(ValidationFails) {
+    twist::stdlike::atomic<uint32_t> word{1};
+    ASSERT_FALSE(solutions::ParkingLot::Park(&word, []() {
+      return false;
+    }));
+    solutions::ParkingLot::Wait(word, 0);  // Value changed, returns
+  }
+
+  SIMPLE_T_TEST(WaitWake) {
+    twist::stdlike::atomic<uint32_t> word{0};
+
+    twist::strand::thread waiter([&]() {
+      while (word.load() == 0) {
+        solutions::ParkingLot::Wait(word, 0);
+      }
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+
+    word.store(1);
+    solutions::ParkingLot::WakeOne(word);
+    waiter.join();
+  }
+
+  SIMPLE_T_TEST(UnparkOneReportsRest) {
+    static const size_t kThreads = 3;
+
+    int address;
+    std::atomic<size_t> parked{0};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t i = 0; i < kThreads; ++i) {
+      executor.Submit([&]() {
+        solutions::ParkingLot::Park(&address, [&]() {
+          parked.fetch_add(1);
+          return true;
+        });
+      });
+    }
+
+    while (parked.load() < kThreads) {
+      twist::strand::this_thread::yield();
+    }
+
+    for (size_t i = 0; i < kThreads; ++i) {
+      solutions::ParkingLot::UnparkOne(&address, [&](auto result) {
+        ASSERT_TRUE(result.unparked);
+        ASSERT_EQ(result.may_have_more, i + 1 < kThreads);
+      });
+    }
+    executor.Join();
+
+    ASSERT_EQ(solutions::ParkingLot::UnparkAll(&address), 0u);
+  }
+
+  SIMPLE_T_TEST(UnparkFiltered) {
+    static const size_t kThreads = 4;
+
+    int address;
+    std::atomic<size_t> parked{0};
+    std::atomic<size_t> unparked{0};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t i = 0; i < kThreads; ++i) {
+      executor.Submit([&, i]() {
+        solutions::ParkingLot::Park(
+            &address,
+            [&]() {
+              parked.fetch_add(1);
+              return true;
+            },
+            /*token=*/i);
+        unparked.fetch_add(1);
+      });
+    }
+
+    while (parked.load() < kThreads) {
+      twist::strand::this_thread::yield();
+    }
+
+    // Odd tokens only
+    size_t count = solutions::ParkingLot::UnparkFiltered(
+        &address, [](uintptr_t token) {
+          return token % 2 == 1;
+        });
+    ASSERT_EQ(count, kThreads / 2);
+
+    ASSERT_EQ(solutions::ParkingLot::UnparkAll(&address), kThreads / 2);
+    executor.Join();
+    ASSERT_EQ(unparked.load(), kThreads);
+  }
+
+  SIMPLE_T_TEST(ParkUntil) {
+    using namespace std::chrono_literals;
+    using solutions::ParkingLot;
+
+    int address;
+    auto deadline = std::chrono::steady_clock::now() + 100ms;
+
+    auto result = ParkingLot::ParkUntil(
+        &address,
+        []() {
+          return true;
+        },
+        deadline);
+    ASSERT_TRUE(result == ParkingLot::ParkResult::TimedOut);
+    ASSERT_TRUE(std::chrono::steady_clock::now() >= deadline);
+
+    // Timed out waiter has left the queue
+    ASSERT_EQ(ParkingLot::UnparkAll(&address), 0u);
+
+    twist::strand::thread unparker([&]() {
+      twist::strand::this_thread::sleep_for(100ms);
+      ParkingLot::UnparkOne(&address);
+    });
+
+    result = ParkingLot::ParkUntil(
+        &address,
+        []() {
+          return true;
+        },
+        std::chrono::steady_clock::now() + 10s);
+    ASSERT_TRUE(result == ParkingLot::ParkResult::Unparked);
+    unparker.join();
+  }
+}
+
+TEST_SUITE(EventCount) {
+  SIMPLE_T_TEST(Notify) {
+    solutions::EventCount event_count;
+    std::atomic<bool> ready{false};
+
+    twist::strand::thread waiter([&]() {
+      while (!ready.load()) {
+        event_count.Await([&]() {
+          return ready.load();
+        });
+      }
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+
+    ready.store(true);
+    event_count.NotifyOne();
+    waiter.join();
+  }
+
+  SIMPLE_T_TEST(CancelWait) {
+    solutions::EventCount event_count;
+    event_count.PrepareWait();
+    event_count.CancelWait();
+    // Nobody waits: no epoch change
+    auto key = event_count.PrepareWait();
+    event_count.NotifyAll();
+    event_count.CommitWait(key);  // Notified, returns
+  }
 }
 
 TEST_SUITE(BufferedChannel) {
@@ -146,6 +463,24 @@ TEST_SUITE(BufferedChannel) {
     producer.join();
   }
 
+  SIMPLE_T_TEST(CapacityOne) {
+    solutions::BufferedChannel<int> chan{1};
+
+    static const int kItems = 100;
+
+    twist::strand::thread producer([&]() {
+      for (int i = 0; i < kItems; ++i) {
+        chan.Send(i);
+      }
+    });
+
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_EQ(chan.Receive(), i);
+    }
+
+    producer.join();
+  }
+
   SIMPLE_T_TEST(Capacity) {
     solutions::BufferedChannel<int> chan{3};
     std::atomic<size_t> send_count{0};
@@ -201,6 +536,213 @@ TEST_SUITE(BufferedChannel) {
 
     chan.Send(-1);
   }
+
+  SIMPLE_T_TEST(TryReceive) {
+    solutions::BufferedChannel<int> chan{2};
+    ASSERT_FALSE(chan.TryReceive().has_value());
+    chan.Send(1);
+    ASSERT_EQ(*chan.TryReceive(), 1);
+    ASSERT_FALSE(chan.TryReceive().has_value());
+  }
+
+  SIMPLE_T_TEST(CloseDrains) {
+    solutions::BufferedChannel<int> chan{3};
+    chan.Send(1);
+    chan.Send(2);
+    chan.Close();
+
+    ASSERT_TRUE(chan.IsClosed());
+    ASSERT_THROW(chan.Send(3), solutions::ChannelClosed);
+
+    ASSERT_EQ(chan.Receive(), 1);
+    ASSERT_EQ(*chan.TryReceive(), 2);
+    ASSERT_FALSE(chan.TryReceive().has_value());
+    ASSERT_THROW(chan.Receive(), solutions::ChannelClosed);
+  }
+
+  SIMPLE_T_TEST(CloseWakesReceivers) {
+    static const size_t kThreads = 5;
+    solutions::BufferedChannel<int> chan{1};
+    std::atomic<size_t> closed{0};
+
+    twist::test_utils::ScopedExecutor executor;
+    for (size_t i = 0; i < kThreads; ++i) {
+      executor.Submit([&]() {
+        ASSERT_THROW(chan.Receive(), solutions::ChannelClosed);
+        closed.fetch_add(1);
+      });
+    }
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+    ASSERT_EQ(closed.load(), 0u);
+
+    chan.Close();
+    executor.Join();
+    ASSERT_EQ(closed.load(), kThreads);
+  }
+
+  SIMPLE_T_TEST(CloseWakesSenders) {
+    solutions::BufferedChannel<int> chan{1};
+    chan.Send(1);
+
+    twist::strand::thread sender([&]() {
+      ASSERT_THROW(chan.Send(2), solutions::ChannelClosed);
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+    chan.Close();
+    sender.join();
+
+    ASSERT_EQ(chan.Receive(), 1);
+  }
+}
+
+TEST_SUITE(Select) {
+  SIMPLE_T_TEST(Ready) {
+    solutions::BufferedChannel<int> a{1};
+    solutions::BufferedChannel<int> b{1};
+
+    b.Send(7);
+    auto selected = solutions::Select({&a, &b});
+    ASSERT_EQ(selected.index, 1u);
+    ASSERT_EQ(*selected.item, 7);
+  }
+
+  SIMPLE_T_TEST(Blocking) {
+    solutions::BufferedChannel<int> a{1};
+    solutions::BufferedChannel<int> b{1};
+    solutions::BufferedChannel<int> c{1};
+
+    twist::strand::thread producer([&]() {
+      twist::strand::this_thread::sleep_for(
+          std::chrono::milliseconds(100));
+      c.Send(42);
+    });
+
+    auto selected = solutions::Select({&a, &b, &c});
+    ASSERT_EQ(selected.index, 2u);
+    ASSERT_EQ(*selected.item, 42);
+
+    producer.join();
+  }
+
+  SIMPLE_T_TEST(Closed) {
+    solutions::BufferedChannel<int> a{1};
+    solutions::BufferedChannel<int> b{1};
+
+    twist::strand::thread closer([&]() {
+      twist::strand::this_thread::sleep_for(
+          std::chrono::milliseconds(100));
+      a.Close();
+    });
+
+    auto selected = solutions::Select({&a, &b});
+    ASSERT_EQ(selected.index, 0u);
+    ASSERT_FALSE(selected.item.has_value());
+
+    closer.join();
+  }
+
+  SIMPLE_T_TEST(NoStarvation) {
+    solutions::BufferedChannel<int> a{16};
+    solutions::BufferedChannel<int> b{16};
+
+    for (int i = 0; i < 16; ++i) {
+      a.Send(0);
+      b.Send(1);
+    }
+
+    size_t from_b = 0;
+    for (size_t i = 0; i < 16; ++i) {
+      from_b += solutions::Select({&a, &b}).index;
+    }
+    ASSERT_TRUE(from_b > 0);
+    ASSERT_TRUE(from_b < 16);
+  }
+}
+
+TEST_SUITE(SPSCChannel) {
+  SIMPLE_T_TEST(SendThenReceive) {
+    solutions::SPSCChannel<int> chan{1};
+    chan.Send(42);
+    ASSERT_EQ(chan.Receive(), 42);
+  }
+
+  SIMPLE_T_TEST(Capacity) {
+    solutions::SPSCChannel<int> chan{5};
+    ASSERT_EQ(chan.Capacity(), 8u);
+  }
+
+  SIMPLE_T_TEST(MoveIt) {
+    solutions::SPSCChannel<std::unique_ptr<std::string>> chan{2};
+    chan.Send(std::make_unique<std::string>("Move it"));
+    ASSERT_EQ(*chan.Receive(), "Move it");
+  }
+
+  SIMPLE_T_TEST(Fifo) {
+    solutions::SPSCChannel<int> chan{4};
+
+    static const int kItems = 1024;
+
+    twist::strand::thread producer([&]() {
+      for (int i = 0; i < kItems; ++i) {
+        chan.Send(i);
+      }
+    });
+
+    for (int i = 0; i < kItems; ++i) {
+      ASSERT_EQ(chan.Receive(), i);
+    }
+
+    producer.join();
+  }
+
+  SIMPLE_T_TEST(Batches) {
+    solutions::SPSCChannel<int> chan{8};
+
+    static const int kItems = 1000;
+
+    twist::strand::thread producer([&]() {
+      std::vector<int> items;
+      for (int i = 0; i < kItems; ++i) {
+        items.push_back(i);
+      }
+      // Larger than capacity
+      chan.SendBatch(items.data(), items.size());
+    });
+
+    int next = 0;
+    int buffer[16];
+    while (next < kItems) {
+      size_t count = chan.ReceiveBatch(buffer, 16);
+      ASSERT_TRUE(count > 0 && count <= 8);
+      for (size_t i = 0; i < count; ++i) {
+        ASSERT_EQ(buffer[i], next++);
+      }
+    }
+
+    producer.join();
+  }
+
+  SIMPLE_T_TEST(BlockingReceive) {
+    solutions::SPSCChannel<int> chan{2};
+
+    std::atomic<bool> received{false};
+
+    twist::strand::thread consumer([&]() {
+      ASSERT_EQ(chan.Receive(), 7);
+      received.store(true);
+    });
+
+    twist::strand::this_thread::sleep_for(
+        std::chrono::milliseconds(100));
+    ASSERT_FALSE(received.load());
+
+    chan.Send(7);
+    consumer.join();
+  }
 }
 
 RUN_ALL_TESTS()
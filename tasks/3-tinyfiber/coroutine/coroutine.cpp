@@ -53,8 +53,7 @@ void Coroutine::CoroutineTrampoline() {
   Coroutine* self = GetCurrentCoroutine();
 
   try {
-    auto routine = self->UserRoutine();
-    routine();
+    self->UserRoutine()();
   } catch (...) {
     auto exception = std::current_exception();
     self->SetException(exception);
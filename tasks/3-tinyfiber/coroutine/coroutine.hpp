@@ -1,10 +1,11 @@
 #pragma once
 
 #include "context.hpp"
+#include "routine.hpp"
 #include "stack.hpp"
 
 #include <exception>
-#include <functional>
+#include <stdexcept>
 
 namespace tinyfiber {
 namespace coroutine {
@@ -19,7 +20,7 @@ struct NotInCoroutine : public std::runtime_error {
   }
 };
 
-using Routine = std::function<void()>;
+using Routine = tinyfiber::Routine;
 
 class Coroutine {
  public:
@@ -34,7 +35,7 @@ class Coroutine {
 
   bool IsCompleted() const;
 
-  Routine UserRoutine() {
+  Routine& UserRoutine() {
     return routine_;
   }
 
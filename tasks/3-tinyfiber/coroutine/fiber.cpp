@@ -6,15 +6,15 @@ namespace tinyfiber {
 
 void Spawn(FiberRoutine routine, ThreadPool& thread_pool) {
   // Not implemented
-  thread_pool.Submit([&]() {
-    auto coro = new coroutine::Coroutine(routine);
+  thread_pool.Submit([routine = std::move(routine)]() mutable {
+    auto coro = new coroutine::Coroutine(std::move(routine));
     coro->Resume();
   });
 }
 
 void Spawn(FiberRoutine routine) {
   // Not implemented
-  auto coro = new coroutine::Coroutine(routine);
+  auto coro = new coroutine::Coroutine(std::move(routine));
   coro->Resume();
 }
 
@@ -1,12 +1,11 @@
 #pragma once
 
-#include <functional>
-
+#include "routine.hpp"
 #include "scheduler.hpp"
 
 namespace tinyfiber {
 
-using FiberRoutine = std::function<void()>;
+using FiberRoutine = Routine;
 
 // Spawn fiber inside provided thread pool
 void Spawn(FiberRoutine routine, ThreadPool& thread_pool);
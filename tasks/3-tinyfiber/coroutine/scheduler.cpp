@@ -14,11 +14,11 @@ ThreadPool::~ThreadPool() {
 }
 
 void ThreadPool::Submit(Task task) {
-  asio::post(io_context_, task);
+  asio::post(io_context_, std::move(task));
 }
 
 void ThreadPool::SubmitContinuation(Task cont) {
-  asio::defer(io_context_, cont);
+  asio::defer(io_context_, std::move(cont));
 }
 
 static thread_local ThreadPool* current{nullptr};
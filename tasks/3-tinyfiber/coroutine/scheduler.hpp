@@ -1,5 +1,7 @@
 #pragma once
 
+#include "routine.hpp"
+
 #include <asio.hpp>
 
 #include <vector>
@@ -11,7 +13,7 @@ namespace tinyfiber {
 // Executes submitted tasks in pooled threads
 class ThreadPool {
  public:
-  using Task = std::function<void()>;
+  using Task = Routine;
 
   ThreadPool(size_t thread_count);
   ~ThreadPool();
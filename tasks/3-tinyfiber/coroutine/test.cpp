@@ -7,6 +7,7 @@
 #include <atomic>
 #include <chrono>
 #include <memory>
+#include <vector>
 
 using namespace std::chrono_literals;
 
@@ -271,11 +272,52 @@ TEST_SUITE(Coroutine) {
 
     ASSERT_FALSE(weak_ptr.lock());
   }
+
+  SIMPLE_TEST(MoveOnlyRoutine) {
+    auto value = std::make_unique<int>(42);
+
+    coroutine::Coroutine co([value = std::move(value)]() mutable {
+      ASSERT_EQ(*value, 42);
+      coroutine::Suspend();
+      value.reset();
+    });
+
+    co.Resume();
+    co.Resume();
+    ASSERT_TRUE(co.IsCompleted());
+  }
+
+  SIMPLE_TEST(HugePageStacks) {
+    static const size_t kCoroutines = 1024;
+
+    tinyfiber::Stack::UseHugePages(true);
+
+    size_t steps = 0;
+    std::vector<std::unique_ptr<coroutine::Coroutine>> coroutines;
+    for (size_t i = 0; i < kCoroutines; ++i) {
+      coroutines.push_back(std::make_unique<coroutine::Coroutine>([&]() {
+        char buffer[1024];
+        buffer[0] = 1;
+        coroutine::Suspend();
+        steps += buffer[0];
+      }));
+    }
+    for (auto& co : coroutines) {
+      co->Resume();
+    }
+    for (auto& co : coroutines) {
+      co->Resume();
+      ASSERT_TRUE(co->IsCompleted());
+    }
+    ASSERT_EQ(steps, kCoroutines);
+
+    tinyfiber::Stack::UseHugePages(false);
+  }
 }
 
 static void RunScheduler(tinyfiber::FiberRoutine init, size_t threads) {
   tinyfiber::ThreadPool thread_pool{threads};
-  tinyfiber::Spawn(init, thread_pool);
+  tinyfiber::Spawn(std::move(init), thread_pool);
   thread_pool.Join();
 }
 
@@ -295,6 +337,21 @@ TEST_SUITE(Fiber) {
     ASSERT_EQ(done.load(), true);
   }
 
+  SIMPLE_TEST(MoveOnlyRoutine) {
+    ThreadPool tp{2};
+    std::atomic<int> value{0};
+
+    auto data = std::make_unique<int>(7);
+
+    Spawn([&value, data = std::move(data)]() {
+      Yield();
+      value.store(*data);
+    }, tp);
+    tp.Join();
+
+    ASSERT_EQ(value.load(), 7);
+  }
+
   SIMPLE_TEST(ChildInsideThreadPool) {
     ThreadPool tp{3};
     std::atomic<size_t> done{0};
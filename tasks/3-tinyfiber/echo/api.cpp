@@ -6,9 +6,10 @@ namespace tinyfiber {
 
 //////////////////////////////////////////////////////////////////////
 
-void RunScheduler(FiberRoutine init) {
+SchedulerStats RunScheduler(FiberRoutine init) {
   Scheduler scheduler;
   scheduler.Run(std::move(init));
+  return scheduler.GetStats();
 }
 
 //////////////////////////////////////////////////////////////////////
@@ -25,4 +26,12 @@ FiberId GetFiberId() {
   return GetCurrentFiber()->Id();
 }
 
+SchedulerStats GetSchedulerStats() {
+  return GetCurrentScheduler()->GetStats();
+}
+
+Duration GetFiberRunningTime() {
+  return GetCurrentFiber()->RunningTime();
+}
+
 }  // namespace tinyfiber
@@ -33,10 +33,18 @@ class Fiber : public IntrusiveListNode<Fiber> {
     state_ = target;
   }
 
-  FiberRoutine UserRoutine() {
+  FiberRoutine& UserRoutine() {
     return routine_;
   }
 
+  Duration RunningTime() const {
+    return running_time_;
+  }
+
+  void AddRunningTime(Duration elapsed) {
+    running_time_ += elapsed;
+  }
+
   static Fiber* Create(FiberRoutine routine);
 
  private:
@@ -50,6 +58,7 @@ class Fiber : public IntrusiveListNode<Fiber> {
   ExecutionContext context_;
   FiberState state_;
   FiberId id_;
+  Duration running_time_{0};
 };
 
 }  // namespace tinyfiber
@@ -0,0 +1,154 @@
+#pragma once
+
+#include <tinysupport/exception.hpp>
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace tinyfiber {
+
+//////////////////////////////////////////////////////////////////////
+
+// Move-only type-erased void() callable
+// Can wrap move-only lambdas (e.g. lambdas capturing std::unique_ptr)
+
+// Small callables are stored inline (no heap allocation),
+// larger ones are allocated on the heap once, at construction.
+// Invoked in place: no copies on start of fiber / coroutine
+
+class Routine {
+  static const size_t kInlineSize = 6 * sizeof(void*);
+  static const size_t kInlineAlignment = alignof(std::max_align_t);
+
+  using Storage = std::aligned_storage_t<kInlineSize, kInlineAlignment>;
+
+  template <typename F>
+  static constexpr bool kFitsInline =
+      sizeof(F) <= kInlineSize && alignof(F) <= kInlineAlignment &&
+      std::is_nothrow_move_constructible<F>::value;
+
+ public:
+  Routine() = default;
+
+  template <typename F,
+            typename = std::enable_if_t<
+                !std::is_same<std::decay_t<F>, Routine>::value>>
+  Routine(F&& f) {
+    Init<std::decay_t<F>>(std::forward<F>(f));
+  }
+
+  // Non-copyable
+  Routine(const Routine& that) = delete;
+  Routine& operator=(const Routine& that) = delete;
+
+  Routine(Routine&& that) noexcept {
+    MoveFrom(that);
+  }
+
+  Routine& operator=(Routine&& that) noexcept {
+    if (this != &that) {
+      Reset();
+      MoveFrom(that);
+    }
+    return *this;
+  }
+
+  ~Routine() {
+    Reset();
+  }
+
+  void operator()() {
+    TINY_VERIFY(vtable_ != nullptr, "Empty routine");
+    vtable_->invoke(&storage_);
+  }
+
+  explicit operator bool() const {
+    return vtable_ != nullptr;
+  }
+
+ private:
+  struct VTable {
+    void (*invoke)(void* storage);
+    // Move-construct callable from 'from' storage to 'to' storage
+    // and destroy it in 'from'
+    void (*relocate)(void* from, void* to);
+    void (*destroy)(void* storage);
+  };
+
+  // Callable lives in storage_
+  template <typename F>
+  struct InlineOps {
+    static F* Get(void* storage) {
+      return std::launder(reinterpret_cast<F*>(storage));
+    }
+
+    static void Invoke(void* storage) {
+      (*Get(storage))();
+    }
+
+    static void Relocate(void* from, void* to) {
+      ::new (to) F(std::move(*Get(from)));
+      Get(from)->~F();
+    }
+
+    static void Destroy(void* storage) {
+      Get(storage)->~F();
+    }
+
+    static constexpr VTable kVTable{Invoke, Relocate, Destroy};
+  };
+
+  // storage_ holds pointer to heap-allocated callable
+  template <typename F>
+  struct HeapOps {
+    static F*& Get(void* storage) {
+      return *std::launder(reinterpret_cast<F**>(storage));
+    }
+
+    static void Invoke(void* storage) {
+      (*Get(storage))();
+    }
+
+    static void Relocate(void* from, void* to) {
+      ::new (to) F*(Get(from));
+    }
+
+    static void Destroy(void* storage) {
+      delete Get(storage);
+    }
+
+    static constexpr VTable kVTable{Invoke, Relocate, Destroy};
+  };
+
+  template <typename F, typename Arg>
+  void Init(Arg&& f) {
+    if constexpr (kFitsInline<F>) {
+      ::new (&storage_) F(std::forward<Arg>(f));
+      vtable_ = &InlineOps<F>::kVTable;
+    } else {
+      ::new (&storage_) F*(new F(std::forward<Arg>(f)));
+      vtable_ = &HeapOps<F>::kVTable;
+    }
+  }
+
+  void MoveFrom(Routine& that) {
+    if (that.vtable_ != nullptr) {
+      that.vtable_->relocate(&that.storage_, &storage_);
+      vtable_ = std::exchange(that.vtable_, nullptr);
+    }
+  }
+
+  void Reset() {
+    if (vtable_ != nullptr) {
+      std::exchange(vtable_, nullptr)->destroy(&storage_);
+    }
+  }
+
+ private:
+  Storage storage_;
+  const VTable* vtable_{nullptr};
+};
+
+}  // namespace tinyfiber
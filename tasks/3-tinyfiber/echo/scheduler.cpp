@@ -1,7 +1,11 @@
 #include "scheduler.hpp"
 
+#include <chrono>
+
 namespace tinyfiber {
 
+using Clock = std::chrono::steady_clock;
+
 //////////////////////////////////////////////////////////////////////
 
 static thread_local Scheduler* current_scheduler;
@@ -43,23 +47,30 @@ void Scheduler::SetCurrentFiber(Fiber* fiber) {
   running_ = fiber;
 }
 
+SchedulerStats Scheduler::GetStats() const {
+  return stats_;
+}
+
 // Operations invoked by running fibers
 
 void Scheduler::SwitchToScheduler() {
   Fiber* caller = GetAndResetCurrentFiber();
+  ++stats_.switches;
   caller->Context().SwitchTo(loop_context_);
 }
 
 // System calls
 
 void Scheduler::Spawn(FiberRoutine routine) {
-  auto* created = CreateFiber(routine);
+  auto* created = CreateFiber(std::move(routine));
+  ++stats_.spawns;
   Schedule(created);
 }
 
 void Scheduler::Yield() {
   Fiber* caller = GetCurrentFiber();
   caller->SetState(FiberState::Runnable);
+  ++stats_.yields;
   SwitchToScheduler();
 }
 
@@ -73,13 +84,14 @@ void Scheduler::Terminate() {
 
 void Scheduler::Run(FiberRoutine init) {
   SchedulerScope scope(this);
-  Spawn(init);
+  Spawn(std::move(init));
   RunLoop();
 }
 
 void Scheduler::RunLoop() {
   while (!run_queue_.IsEmpty()) {
     Fiber* next = run_queue_.PopFront();
+    --stats_.run_queue_length;
     SwitchTo(next);
     Reschedule(next);
   }
@@ -88,8 +100,15 @@ void Scheduler::RunLoop() {
 void Scheduler::SwitchTo(Fiber* fiber) {
   SetCurrentFiber(fiber);
   fiber->SetState(FiberState::Running);
+  ++stats_.switches;
+
+  auto start = Clock::now();
   // Scheduler loop_context_ -> fiber->context_
   loop_context_.SwitchTo(fiber->Context());
+  auto elapsed = Clock::now() - start;
+
+  fiber->AddRunningTime(std::chrono::duration_cast<Duration>(elapsed));
+  stats_.running_time += std::chrono::duration_cast<Duration>(elapsed);
 }
 
 void Scheduler::Reschedule(Fiber* fiber) {
@@ -108,10 +127,11 @@ void Scheduler::Reschedule(Fiber* fiber) {
 
 void Scheduler::Schedule(Fiber* fiber) {
   run_queue_.PushBack(fiber);
+  ++stats_.run_queue_length;
 }
 
 Fiber* Scheduler::CreateFiber(FiberRoutine routine) {
-  return Fiber::Create(routine);
+  return Fiber::Create(std::move(routine));
 }
 
 void Scheduler::Destroy(Fiber* fiber) {
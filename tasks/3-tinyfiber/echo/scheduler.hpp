@@ -11,6 +11,8 @@ namespace tinyfiber {
 
 using FiberQueue = IntrusiveList<Fiber>;
 
+//////////////////////////////////////////////////////////////////////
+
 class Scheduler {
  public:
   Scheduler();
@@ -25,6 +27,10 @@ class Scheduler {
 
   Fiber* GetCurrentFiber();
 
+  // Scheduler thread only: fibers of this scheduler see the counters
+  // via GetSchedulerStats, everyone else gets them from RunScheduler
+  SchedulerStats GetStats() const;
+
  private:
   void RunLoop();
 
@@ -46,6 +52,8 @@ class Scheduler {
   ExecutionContext loop_context_;
   FiberQueue run_queue_;
   Fiber* running_{nullptr};
+
+  SchedulerStats stats_;
 };
 
 //////////////////////////////////////////////////////////////////////
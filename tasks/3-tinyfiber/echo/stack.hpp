@@ -15,22 +15,37 @@ class Stack {
 
   static Stack Allocate();
 
-  Stack(Stack&& that) = default;
-  Stack& operator=(Stack&& that) = default;
+  // Subsequent Allocate calls carve stacks from pooled 2MB slabs
+  // backed by huge pages (explicit or transparent), see stack.cpp
+  //
+  // Pooled stacks have no guard page: stack overflow does not crash,
+  // it silently corrupts the adjacent stack. Enable only for fibers
+  // with small, known stack usage
+  static void UseHugePages(bool enable);
+
+  Stack(Stack&& that);
+  Stack& operator=(Stack&& that);
+
+  ~Stack();
 
   char* Bottom() const;
 
   size_t Size() const {
-    return allocation_.Size();
+    return AsMemSpan().Size();
   }
 
   MemSpan AsMemSpan() const;
 
  private:
   Stack(MmapAllocation allocation);
+  Stack(MemSpan pooled);
+
+  void Release();
 
  private:
   MmapAllocation allocation_;
+  // Stack from huge page pool
+  MemSpan pooled_;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -1,21 +1,38 @@
 #pragma once
 
-#include <tinysupport/time.hpp>
+#include "routine.hpp"
 
-#include <functional>
+#include <tinysupport/time.hpp>
 
 namespace tinyfiber {
 
 //////////////////////////////////////////////////////////////////////
 
-using FiberRoutine = std::function<void()>;
+using FiberRoutine = Routine;
 
 using FiberId = size_t;
 
 //////////////////////////////////////////////////////////////////////
 
-// Runs 'init' routine in fiber scheduler in the current thread
-void RunScheduler(FiberRoutine init);
+// Snapshot of the scheduler counters
+
+struct SchedulerStats {
+  // Context switches: scheduler -> fiber and fiber -> scheduler
+  size_t switches = 0;
+  size_t yields = 0;
+  size_t spawns = 0;
+  size_t sleeps = 0;
+  // Runnable fibers waiting in the run queue
+  size_t run_queue_length = 0;
+  // Total time spent running fibers
+  Duration running_time{0};
+};
+
+//////////////////////////////////////////////////////////////////////
+
+// Runs 'init' routine in fiber scheduler in the current thread,
+// returns the final scheduler stats
+SchedulerStats RunScheduler(FiberRoutine init);
 
 //////////////////////////////////////////////////////////////////////
 
@@ -37,4 +54,11 @@ void SleepFor(Duration duration);
 // Returns the id of the current fiber
 FiberId GetFiberId();
 
+// Returns the stats of the current scheduler
+SchedulerStats GetSchedulerStats();
+
+// Returns the time the current fiber has spent running
+// before the current run
+Duration GetFiberRunningTime();
+
 }  // namespace tinyfiber
@@ -20,9 +20,6 @@ struct ExecutionContext {
   // 'target' context. 'target' context created directly by Setup or
   // by another target.SwitchTo(other) call.
   void SwitchTo(ExecutionContext& target);
-
-  // For testing purposes
-  static size_t SwitchCount();
 };
 
 }  // namespace tinyfiber
@@ -1,8 +1,12 @@
 #include "scheduler.hpp"
 #include "timer.hpp"
 
+#include <chrono>
+
 namespace tinyfiber {
 
+using Clock = std::chrono::steady_clock;
+
 //////////////////////////////////////////////////////////////////////
 
 static thread_local Scheduler* current_scheduler;
@@ -44,23 +48,30 @@ void Scheduler::SetCurrentFiber(Fiber* fiber) {
   running_ = fiber;
 }
 
+SchedulerStats Scheduler::GetStats() const {
+  return stats_;
+}
+
 // Operations invoked by running fibers
 
 void Scheduler::SwitchToScheduler() {
   Fiber* caller = GetAndResetCurrentFiber();
+  ++stats_.switches;
   caller->Context().SwitchTo(loop_context_);
 }
 
 // System calls
 
 void Scheduler::Spawn(FiberRoutine routine) {
-  auto* created = CreateFiber(routine);
+  auto* created = CreateFiber(std::move(routine));
+  ++stats_.spawns;
   Schedule(created);
 }
 
 void Scheduler::Yield() {
   Fiber* caller = GetCurrentFiber();
   caller->SetState(FiberState::Runnable);
+  ++stats_.yields;
   SwitchToScheduler();
 }
 
@@ -74,6 +85,7 @@ void Scheduler::SleepFor(Duration duration) {
 
   Fiber* fiber = GetCurrentFiber();
   fiber->SetState(FiberState::Sleeping);
+  ++stats_.sleeps;
 
   WaitableTimer timer(run_context_, duration);
   timer.async_wait([this, fiber](asio::error_code err) {
@@ -97,7 +109,7 @@ void Scheduler::Terminate() {
 
 void Scheduler::Run(FiberRoutine init) {
   SchedulerScope scope(this);
-  Spawn(init);
+  Spawn(std::move(init));
   RunLoop();
 }
 
@@ -110,8 +122,15 @@ void Scheduler::RunLoop() {
 void Scheduler::SwitchTo(Fiber* fiber) {
   SetCurrentFiber(fiber);
   fiber->SetState(FiberState::Running);
+  ++stats_.switches;
+
+  auto start = Clock::now();
   // Scheduler loop_context_ -> fiber->context_
   loop_context_.SwitchTo(fiber->Context());
+  auto elapsed = Clock::now() - start;
+
+  fiber->AddRunningTime(std::chrono::duration_cast<Duration>(elapsed));
+  stats_.running_time += std::chrono::duration_cast<Duration>(elapsed);
 }
 
 void Scheduler::Reschedule(Fiber* fiber) {
@@ -132,8 +151,10 @@ void Scheduler::Reschedule(Fiber* fiber) {
 }
 
 void Scheduler::AddToQueue(Fiber* fiber) {
+  ++stats_.run_queue_length;
   run_context_.post([this, fiber]() {
     // handler code
+    --stats_.run_queue_length;
     SwitchTo(fiber);
     Reschedule(fiber);
   });
@@ -145,7 +166,7 @@ void Scheduler::Schedule(Fiber* fiber) {
 }
 
 Fiber* Scheduler::CreateFiber(FiberRoutine routine) {
-  return Fiber::Create(routine);
+  return Fiber::Create(std::move(routine));
 }
 
 void Scheduler::Destroy(Fiber* fiber) {
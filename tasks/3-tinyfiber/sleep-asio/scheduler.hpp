@@ -11,6 +11,8 @@ namespace tinyfiber {
 
 using FiberQueue = IntrusiveList<Fiber>;
 
+//////////////////////////////////////////////////////////////////////
+
 class Scheduler {
  public:
   Scheduler();
@@ -26,6 +28,10 @@ class Scheduler {
 
   Fiber* GetCurrentFiber();
 
+  // Scheduler thread only: fibers of this scheduler see the counters
+  // via GetSchedulerStats, everyone else gets them from RunScheduler
+  SchedulerStats GetStats() const;
+
  private:
   void RunLoop();
 
@@ -49,6 +55,8 @@ class Scheduler {
   ExecutionContext loop_context_;
   asio::io_context run_context_;
   Fiber* running_{nullptr};
+
+  SchedulerStats stats_;
 };
 
 //////////////////////////////////////////////////////////////////////
@@ -14,20 +14,6 @@
 
 // Test utils
 
-class ContextSwitchCounter {
- public:
-  ContextSwitchCounter()
-    : start_count_{tinyfiber::ExecutionContext::SwitchCount()} {
-  }
-
-  size_t Get() const {
-    return tinyfiber::ExecutionContext::SwitchCount() - start_count_;
-  }
-
- private:
-  size_t start_count_;
-};
-
 class CPUTimer {
  public:
   CPUTimer() {
@@ -96,12 +82,11 @@ TEST_SUITE(Scheduler) {
     };
 
     CPUTimer cpu_timer;
-    ContextSwitchCounter switch_counter;
 
-    tinyfiber::RunScheduler(sleeper);
+    auto stats = tinyfiber::RunScheduler(sleeper);
 
     const auto cpu_time_seconds = cpu_timer.SecondsElapsed();
-    const auto switch_count = switch_counter.Get();
+    const auto switch_count = stats.switches;
 
     std::cout << "CPU time: " << cpu_time_seconds << " seconds" << std::endl;
     std::cout << "Switch count: " << switch_count << std::endl;
@@ -110,6 +95,62 @@ TEST_SUITE(Scheduler) {
     ASSERT_TRUE(switch_count < 10);
   }
 
+  SIMPLE_TEST(Stats) {
+    static const size_t kFibers = 10;
+    static const size_t kYields = 5;
+
+    auto worker = []() {
+      for (size_t i = 0; i < kYields; ++i) {
+        tinyfiber::Yield();
+      }
+      tinyfiber::SleepFor(std::chrono::milliseconds(10));
+    };
+
+    auto stats = tinyfiber::RunScheduler([&]() {
+      for (size_t i = 0; i < kFibers; ++i) {
+        tinyfiber::Spawn(worker);
+      }
+      auto current = tinyfiber::GetSchedulerStats();
+      ASSERT_EQ(current.spawns, kFibers + 1);
+      ASSERT_EQ(current.run_queue_length, kFibers);
+    });
+
+    ASSERT_EQ(stats.spawns, kFibers + 1);
+    ASSERT_EQ(stats.yields, kFibers * kYields);
+    ASSERT_EQ(stats.sleeps, kFibers);
+    ASSERT_EQ(stats.run_queue_length, 0);
+    // Each run of a fiber: scheduler -> fiber -> scheduler
+    ASSERT_EQ(stats.switches, 2 * (1 + kFibers * (kYields + 2)));
+  }
+
+  SIMPLE_TEST(RunningTime) {
+    using namespace std::chrono_literals;
+
+    auto busy = [](auto duration) {
+      auto deadline = std::chrono::steady_clock::now() + duration;
+      while (std::chrono::steady_clock::now() < deadline) {
+        // Burn CPU
+      }
+    };
+
+    auto stats = tinyfiber::RunScheduler([&]() {
+      ASSERT_TRUE(tinyfiber::GetFiberRunningTime() < 10ms);
+
+      busy(100ms);
+      tinyfiber::Yield();
+      // Counts previous runs only
+      auto running_time = tinyfiber::GetFiberRunningTime();
+      ASSERT_TRUE(running_time >= 100ms);
+
+      // Sleeping is not running
+      tinyfiber::SleepFor(100ms);
+      ASSERT_TRUE(tinyfiber::GetFiberRunningTime() < running_time + 50ms);
+    });
+
+    ASSERT_TRUE(stats.running_time >= 100ms);
+    ASSERT_TRUE(stats.running_time < 150ms);
+  }
+
   SIMPLE_TEST(SleepAndRun) {
     size_t runner_steps = 0;
 
@@ -6,15 +6,16 @@ namespace tinyfiber {
 
 //////////////////////////////////////////////////////////////////////
 
-void RunScheduler(FiberRoutine init) {
+SchedulerStats RunScheduler(FiberRoutine init) {
   Scheduler scheduler;
-  scheduler.Run(init);
+  scheduler.Run(std::move(init));
+  return scheduler.GetStats();
 }
 
 //////////////////////////////////////////////////////////////////////
 
 void Spawn(FiberRoutine routine) {
-  GetCurrentScheduler()->Spawn(routine);
+  GetCurrentScheduler()->Spawn(std::move(routine));
 }
 
 void Yield() {
@@ -29,4 +30,12 @@ FiberId GetFiberId() {
   return GetCurrentFiber()->Id();
 }
 
+SchedulerStats GetSchedulerStats() {
+  return GetCurrentScheduler()->GetStats();
+}
+
+Duration GetFiberRunningTime() {
+  return GetCurrentFiber()->RunningTime();
+}
+
 }  // namespace tinyfiber
@@ -46,16 +46,8 @@ void ExecutionContext::Setup(MemSpan stack, Trampoline trampoline) {
   rsp_ = saved_context;
 }
 
-static size_t switch_count = 0;
-
 void ExecutionContext::SwitchTo(ExecutionContext& target) {
-  ++switch_count;
   SwitchContext(this, &target);
 }
 
-// For testing purposes
-size_t ExecutionContext::SwitchCount() {
-  return switch_count;
-}
-
 }  // namespace tinyfiber
@@ -1,8 +1,12 @@
 #include "scheduler.hpp"
 #include <twist/stdlike/thread.hpp>
 
+#include <chrono>
+
 namespace tinyfiber {
 
+using Clock = std::chrono::steady_clock;
+
 //////////////////////////////////////////////////////////////////////
 
 static thread_local Scheduler* current_scheduler;
@@ -44,23 +48,30 @@ void Scheduler::SetCurrentFiber(Fiber* fiber) {
   running_ = fiber;
 }
 
+SchedulerStats Scheduler::GetStats() const {
+  return stats_;
+}
+
 // Operations invoked by running fibers
 
 void Scheduler::SwitchToScheduler() {
   Fiber* caller = GetAndResetCurrentFiber();
+  ++stats_.switches;
   caller->Context().SwitchTo(loop_context_);
 }
 
 // System calls
 
 void Scheduler::Spawn(FiberRoutine routine) {
-  auto* created = CreateFiber(routine);
+  auto* created = CreateFiber(std::move(routine));
+  ++stats_.spawns;
   Schedule(created);
 }
 
 void Scheduler::Yield() {
   Fiber* caller = GetCurrentFiber();
   caller->SetState(FiberState::Runnable);
+  ++stats_.yields;
   SwitchToScheduler();
 }
 
@@ -68,12 +79,13 @@ void Scheduler::SleepFor(Duration duration) {
   Fiber* caller = GetCurrentFiber();
   sleep_queue_.PutFiberSleepFor(caller, duration);
   caller->SetState(FiberState::Sleeping);
+  ++stats_.sleeps;
   SwitchToScheduler();
 }
 
 void Scheduler::WakeUpFiber(Fiber* fiber) {
   fiber->SetState(FiberState::Runnable);
-  run_queue_.PushBack(fiber);
+  Schedule(fiber);
 }
 
 void Scheduler::Terminate() {
@@ -86,7 +98,7 @@ void Scheduler::Terminate() {
 
 void Scheduler::Run(FiberRoutine init) {
   SchedulerScope scope(this);
-  Spawn(init);
+  Spawn(std::move(init));
   RunLoop();
 }
 
@@ -98,6 +110,7 @@ Fiber* Scheduler::GetNextFiber() {
         Duration(sleep_queue_.MinSleepTime()));
     WakeUpFiber(sleep_queue_.TakeReadyToWakeUpFiber());
   }
+  --stats_.run_queue_length;
   return run_queue_.PopFront();
 }
 
@@ -112,8 +125,15 @@ void Scheduler::RunLoop() {
 void Scheduler::SwitchTo(Fiber* fiber) {
   SetCurrentFiber(fiber);
   fiber->SetState(FiberState::Running);
+  ++stats_.switches;
+
+  auto start = Clock::now();
   // Scheduler loop_context_ -> fiber->context_
   loop_context_.SwitchTo(fiber->Context());
+  auto elapsed = Clock::now() - start;
+
+  fiber->AddRunningTime(std::chrono::duration_cast<Duration>(elapsed));
+  stats_.running_time += std::chrono::duration_cast<Duration>(elapsed);
 }
 
 void Scheduler::Reschedule(Fiber* fiber) {
@@ -135,10 +155,11 @@ void Scheduler::Reschedule(Fiber* fiber) {
 
 void Scheduler::Schedule(Fiber* fiber) {
   run_queue_.PushBack(fiber);
+  ++stats_.run_queue_length;
 }
 
 Fiber* Scheduler::CreateFiber(FiberRoutine routine) {
-  return Fiber::Create(routine);
+  return Fiber::Create(std::move(routine));
 }
 
 void Scheduler::Destroy(Fiber* fiber) {
@@ -10,6 +10,8 @@ namespace tinyfiber {
 
 using FiberQueue = IntrusiveList<Fiber>;
 
+//////////////////////////////////////////////////////////////////////
+
 class Scheduler {
  public:
   Scheduler();
@@ -25,6 +27,10 @@ class Scheduler {
 
   Fiber* GetCurrentFiber();
 
+  // Scheduler thread only: fibers of this scheduler see the counters
+  // via GetSchedulerStats, everyone else gets them from RunScheduler
+  SchedulerStats GetStats() const;
+
  private:
   void WakeUpFiber(Fiber* fiber);
 
@@ -50,6 +56,8 @@ class Scheduler {
   FiberQueue run_queue_;
   SleepQueue sleep_queue_;
   Fiber* running_{nullptr};
+
+  SchedulerStats stats_;
 };
 
 //////////////////////////////////////////////////////////////////////
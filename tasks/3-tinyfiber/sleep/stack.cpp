@@ -1,25 +1,188 @@
 #include "stack.hpp"
 
+#include <twist/strand/spin_wait.hpp>
+
+#include <atomic>
+#include <new>
 #include <utility>
 
+#include <sys/mman.h>
+
 namespace tinyfiber {
 
-static const size_t kStackPages = 8;  // 8KB stacks
+static const size_t kStackPages = 8;  // 32KB stacks
+
+//////////////////////////////////////////////////////////////////////
+
+// Huge page stack pool
+
+// Stacks are carved from 2MB slabs: one TLB entry covers 64 stacks
+// instead of one entry per 4KB page. Slab is backed by explicit huge page (MAP_HUGETLB)
+// if the system has reserved ones, otherwise by transparent huge pages
+// (MADV_HUGEPAGE), otherwise by regular pages.
+//
+// Guard pages would split huge page (and cannot be set at all inside
+// MAP_HUGETLB mapping), so pooled stacks have none: stack overflow
+// silently corrupts the neighbour stack, see Stack::UseHugePages.
+//
+// Released stacks are reused, slabs are never unmapped
+
+static const size_t kHugePageSize = 2 * 1024 * 1024;
+
+class StackPool {
+  struct FreeStack {
+    FreeStack* next;
+  };
+
+ public:
+  MemSpan Allocate() {
+    Lock();
+    if (free_ == nullptr) {
+      AddSlab();
+    }
+    FreeStack* stack = free_;
+    free_ = stack->next;
+    Unlock();
+
+    return MemSpan((char*)stack, StackSize());
+  }
+
+  void Release(MemSpan stack) {
+    auto* node = (FreeStack*)stack.Begin();
+    Lock();
+    node->next = free_;
+    free_ = node;
+    Unlock();
+  }
+
+  void Enable(bool enable) {
+    enabled_.store(enable);
+  }
+
+  bool IsEnabled() const {
+    return enabled_.load();
+  }
+
+ private:
+  static size_t StackSize() {
+    return kStackPages * MmapAllocation::PageSize();
+  }
+
+  // Under lock
+  void AddSlab() {
+    char* slab = MapSlab();
+    for (size_t offset = kHugePageSize; offset > 0; offset -= StackSize()) {
+      auto* stack = (FreeStack*)(slab + offset - StackSize());
+      stack->next = free_;
+      free_ = stack;
+    }
+  }
+
+  static char* MapSlab() {
+    void* slab = mmap(nullptr, kHugePageSize, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+    if (slab != MAP_FAILED) {
+      return (char*)slab;
+    }
+
+    // No reserved huge pages: map twice the size to align slab
+    // to huge page boundary, then trim
+    size_t size = 2 * kHugePageSize;
+    char* start = (char*)mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                              MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (start == MAP_FAILED) {
+      throw std::bad_alloc();
+    }
+
+    char* aligned = (char*)(((std::uintptr_t)start + kHugePageSize - 1) &
+                            ~(std::uintptr_t)(kHugePageSize - 1));
+    if (aligned > start) {
+      munmap(start, aligned - start);
+    }
+    char* end = start + size;
+    if (aligned + kHugePageSize < end) {
+      munmap(aligned + kHugePageSize, end - aligned - kHugePageSize);
+    }
+
+    // Fails without THP support: regular pages then
+    madvise(aligned, kHugePageSize, MADV_HUGEPAGE);
+    return aligned;
+  }
+
+  // Test-and-test-and-set: critical sections are short
+  void Lock() {
+    twist::strand::SpinWait spin_wait;
+    while (locked_.exchange(true, std::memory_order_acquire)) {
+      do {
+        spin_wait();
+      } while (locked_.load(std::memory_order_relaxed));
+    }
+  }
+
+  void Unlock() {
+    locked_.store(false, std::memory_order_release);
+  }
+
+ private:
+  std::atomic<bool> enabled_{false};
+  std::atomic<bool> locked_{false};
+  FreeStack* free_ = nullptr;
+};
+
+static StackPool stack_pool;
+
+//////////////////////////////////////////////////////////////////////
 
 Stack::Stack(MmapAllocation allocation) : allocation_(std::move(allocation)) {
 }
 
+Stack::Stack(MemSpan pooled) : pooled_(pooled) {
+}
+
+Stack::Stack(Stack&& that)
+    : allocation_(std::move(that.allocation_)),
+      pooled_(std::exchange(that.pooled_, MemSpan())) {
+}
+
+Stack& Stack::operator=(Stack&& that) {
+  Release();
+  allocation_ = std::move(that.allocation_);
+  pooled_ = std::exchange(that.pooled_, MemSpan());
+  return *this;
+}
+
+Stack::~Stack() {
+  Release();
+}
+
+void Stack::Release() {
+  if (pooled_.Size() > 0) {
+    stack_pool.Release(pooled_);
+    pooled_ = MemSpan();
+  }
+}
+
 Stack Stack::Allocate() {
+  if (stack_pool.IsEnabled()) {
+    return Stack{stack_pool.Allocate()};
+  }
   auto allocation = MmapAllocation::AllocatePages(kStackPages);
   allocation.ProtectPages(/*offset=*/0, /*count=*/1);
   return Stack{std::move(allocation)};
 }
 
+void Stack::UseHugePages(bool enable) {
+  stack_pool.Enable(enable);
+}
+
 char* Stack::Bottom() const {
-  return (char*)((std::uintptr_t*)allocation_.End() - 1);
+  return (char*)((std::uintptr_t*)AsMemSpan().End() - 1);
 }
 
 MemSpan Stack::AsMemSpan() const {
+  if (pooled_.Size() > 0) {
+    return pooled_;
+  }
   return allocation_.AsMemSpan();
 }
 